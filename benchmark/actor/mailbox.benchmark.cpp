@@ -0,0 +1,79 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/actor/actor.hpp>
+#include <mbgl/util/default_thread_pool.hpp>
+
+#include <atomic>
+#include <future>
+#include <thread>
+#include <vector>
+
+using namespace mbgl;
+
+namespace {
+
+constexpr std::size_t messagesPerProducer = 10000;
+
+class Sink {
+public:
+    Sink(ActorRef<Sink>, std::atomic<std::size_t>& remaining_, std::promise<void>& done_)
+        : remaining(remaining_),
+          done(done_) {
+    }
+
+    void receive(std::size_t) {
+        if (--remaining == 0) {
+            done.set_value();
+        }
+    }
+
+private:
+    std::atomic<std::size_t>& remaining;
+    std::promise<void>& done;
+};
+
+} // end namespace
+
+// Many threads sending to a single actor: measures contention on the mailbox itself.
+static void runMailboxContention(::benchmark::State& state, ReceiveQuantum quantum) {
+    const std::size_t producers = state.range_x();
+    ThreadPool pool(1, quantum);
+
+    while (state.KeepRunning()) {
+        std::atomic<std::size_t> remaining { producers * messagesPerProducer };
+        std::promise<void> done;
+        std::future<void> future = done.get_future();
+
+        Actor<Sink> sink(pool, std::ref(remaining), std::ref(done));
+        ActorRef<Sink> ref = sink.self();
+
+        std::vector<std::thread> threads;
+        for (std::size_t i = 0; i < producers; ++i) {
+            threads.emplace_back([ref]() mutable {
+                for (std::size_t j = 0; j < messagesPerProducer; ++j) {
+                    ref.invoke(&Sink::receive, j);
+                }
+            });
+        }
+
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        future.wait();
+    }
+
+    state.SetItemsProcessed(state.iterations() * producers * messagesPerProducer);
+}
+
+static void Actor_MailboxContention(::benchmark::State& state) {
+    runMailboxContention(state, {});
+}
+
+// Same, but draining up to 64 messages per scheduling quantum.
+static void Actor_MailboxContentionBatched(::benchmark::State& state) {
+    runMailboxContention(state, { 64 });
+}
+
+BENCHMARK(Actor_MailboxContention)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->UseRealTime();
+BENCHMARK(Actor_MailboxContentionBatched)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->UseRealTime();
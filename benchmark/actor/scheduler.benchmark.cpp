@@ -0,0 +1,68 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/actor/actor.hpp>
+#include <mbgl/util/default_thread_pool.hpp>
+#include <mbgl/util/work_stealing_thread_pool.hpp>
+
+#include <atomic>
+#include <future>
+#include <memory>
+#include <vector>
+
+using namespace mbgl;
+
+namespace {
+
+constexpr std::size_t actorCount = 256;
+constexpr std::size_t messageCount = 100;
+
+class Counter {
+public:
+    Counter(ActorRef<Counter>, std::atomic<std::size_t>& remaining_, std::promise<void>& done_)
+        : remaining(remaining_),
+          done(done_) {
+    }
+
+    void receive() {
+        if (--remaining == 0) {
+            done.set_value();
+        }
+    }
+
+private:
+    std::atomic<std::size_t>& remaining;
+    std::promise<void>& done;
+};
+
+} // end namespace
+
+template <class Pool>
+static void Actor_SchedulerThroughput(::benchmark::State& state) {
+    Pool pool(state.range_x());
+
+    while (state.KeepRunning()) {
+        std::atomic<std::size_t> remaining { actorCount * messageCount };
+        std::promise<void> done;
+        std::future<void> future = done.get_future();
+
+        std::vector<std::unique_ptr<Actor<Counter>>> actors;
+        for (std::size_t i = 0; i < actorCount; ++i) {
+            actors.push_back(std::make_unique<Actor<Counter>>(pool, std::ref(remaining), std::ref(done)));
+        }
+
+        for (std::size_t i = 0; i < messageCount; ++i) {
+            for (auto& actor : actors) {
+                actor->invoke(&Counter::receive);
+            }
+        }
+
+        future.wait();
+    }
+
+    state.SetItemsProcessed(state.iterations() * actorCount * messageCount);
+}
+
+BENCHMARK_TEMPLATE(Actor_SchedulerThroughput, ThreadPool)
+    ->Arg(1)->Arg(4)->Arg(16)->Arg(64)->UseRealTime();
+BENCHMARK_TEMPLATE(Actor_SchedulerThroughput, WorkStealingThreadPool)
+    ->Arg(1)->Arg(4)->Arg(16)->Arg(64)->UseRealTime();
@@ -2,10 +2,13 @@
 
 #include <mbgl/style/filter.hpp>
 #include <mbgl/style/filter_evaluator.hpp>
+#include <mbgl/style/compiled_filter.hpp>
 #include <mbgl/style/rapidjson_conversion.hpp>
 #include <mbgl/style/conversion.hpp>
 #include <mbgl/style/conversion/filter.hpp>
 #include <mbgl/tile/geometry_tile_data.hpp>
+#include <mbgl/tile/vector_tile_data.hpp>
+#include <mbgl/util/io.hpp>
 
 #include <rapidjson/document.h>
 
@@ -38,5 +41,40 @@ static void Parse_EvaluateFilter(benchmark::State& state) {
     }
 }
 
+static const char* roadFilter =
+    R"FILTER(["all", ["==", "$type", "LineString"], ["in", "class", "motorway", "trunk", "primary", "secondary"], ["!=", "structure", "tunnel"]])FILTER";
+
+static void Parse_EvaluateFilterVectorTile(benchmark::State& state) {
+    const style::Filter filter = parse(roadFilter);
+    const VectorTileData data(std::make_shared<std::string>(
+        util::read_file("test/fixtures/api/assets/streets/10-163-395.vector.pbf")));
+    const GeometryTileLayer& layer = *data.getLayer("road");
+
+    while (state.KeepRunning()) {
+        layer.eachFeature([&] (std::size_t, const GeometryTileFeature& feature) {
+            benchmark::DoNotOptimize(filter(feature));
+            return true;
+        });
+    }
+}
+
+static void Parse_EvaluateCompiledFilterVectorTile(benchmark::State& state) {
+    const style::Filter filter = parse(roadFilter);
+    const VectorTileData data(std::make_shared<std::string>(
+        util::read_file("test/fixtures/api/assets/streets/10-163-395.vector.pbf")));
+    const GeometryTileLayer& layer = *data.getLayer("road");
+
+    while (state.KeepRunning()) {
+        // Compilation happens once per layer during layout, so include it here.
+        const style::CompiledFilter compiled(filter, layer);
+        layer.eachFeature([&] (std::size_t, const GeometryTileFeature& feature) {
+            benchmark::DoNotOptimize(compiled(feature));
+            return true;
+        });
+    }
+}
+
 BENCHMARK(Parse_Filter);
 BENCHMARK(Parse_EvaluateFilter);
+BENCHMARK(Parse_EvaluateFilterVectorTile);
+BENCHMARK(Parse_EvaluateCompiledFilterVectorTile);
@@ -0,0 +1,167 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/style/conversion/geojson.hpp>
+#include <mbgl/util/geobuf_reader.hpp>
+#include <mbgl/util/geojson_reader.hpp>
+#include <mbgl/util/rapidjson.hpp>
+
+#include <protozero/pbf_writer.hpp>
+
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace mbgl;
+
+namespace {
+
+// `count` polygons of 32 vertices, each with a name and a rank, as GeoJSON text and as
+// Geobuf with the same six decimal places.
+class Data {
+public:
+    explicit Data(std::size_t count) {
+        const int64_t scale = 1000000;
+        const std::size_t vertices = 32;
+
+        std::ostringstream json;
+        json << std::fixed << std::setprecision(6);
+        json << R"JSON({"type":"FeatureCollection","features":[)JSON";
+
+        protozero::pbf_writer pbf(geobuf);
+        pbf.add_string(1 /* keys */, "name");
+        pbf.add_string(1 /* keys */, "rank");
+        protozero::pbf_writer collection(pbf, 4 /* feature_collection */);
+
+        for (std::size_t i = 0; i < count; ++i) {
+            const double lng = -170.0 + 340.0 * (i % 1000) / 1000;
+            const double lat = -80.0 + 160.0 * (i / 1000 % 1000) / 1000;
+
+            std::vector<int64_t> coords;
+            for (std::size_t v = 0; v < vertices; ++v) {
+                const double angle = 2 * M_PI * v / vertices;
+                coords.push_back(std::llround((lng + 0.1 * std::cos(angle)) * scale));
+                coords.push_back(std::llround((lat + 0.1 * std::sin(angle)) * scale));
+            }
+
+            json << (i ? "," : "") << R"JSON({"type":"Feature","properties":{"name":"feature )JSON"
+                 << i << R"JSON(","rank":)JSON" << i % 10
+                 << R"JSON(},"geometry":{"type":"Polygon","coordinates":[[)JSON";
+            for (std::size_t v = 0; v <= vertices; ++v) {
+                const std::size_t c = 2 * (v % vertices);
+                json << (v ? "," : "") << "[" << double(coords[c]) / scale << ","
+                     << double(coords[c + 1]) / scale << "]";
+            }
+            json << "]]}}";
+
+            protozero::pbf_writer feature(collection, 1 /* features */);
+            {
+                protozero::pbf_writer geometry(feature, 1 /* geometry */);
+                geometry.add_enum(1 /* type */, 4 /* POLYGON */);
+                std::vector<int64_t> deltas(coords.size());
+                for (std::size_t c = 0; c < coords.size(); ++c) {
+                    deltas[c] = coords[c] - (c < 2 ? 0 : coords[c - 2]);
+                }
+                geometry.add_packed_sint64(3 /* coords */, deltas.begin(), deltas.end());
+            }
+            {
+                protozero::pbf_writer value(feature, 13 /* values */);
+                value.add_string(1 /* string_value */, "feature " + std::to_string(i));
+            }
+            {
+                protozero::pbf_writer value(feature, 13 /* values */);
+                value.add_uint64(3 /* pos_int_value */, i % 10);
+            }
+            const std::vector<uint32_t> properties = { 0, 0, 1, 1 };
+            feature.add_packed_uint32(14 /* properties */, properties.begin(), properties.end());
+        }
+
+        json << "]}";
+        text = json.str();
+    }
+
+    std::string text;
+    std::string geobuf;
+};
+
+// Peak resident set size, measured from the resident set size when it is created. The
+// peak can only be reset on Linux; elsewhere, nothing is measured.
+class PeakRSS {
+public:
+    PeakRSS() {
+#if defined(__linux__)
+        std::ofstream("/proc/self/clear_refs") << "5";
+        baseline = read("VmRSS:");
+#endif
+    }
+
+    void report(benchmark::State& state, std::size_t dataSize) {
+#if defined(__linux__)
+        state.SetLabel("data " + std::to_string(dataSize / 1024) + " kB, peak RSS +" +
+                       std::to_string(read("VmHWM:") - baseline) + " kB");
+#else
+        state.SetLabel("data " + std::to_string(dataSize / 1024) + " kB");
+#endif
+    }
+
+private:
+#if defined(__linux__)
+    static long read(const std::string& field) {
+        std::ifstream status("/proc/self/status");
+        std::string line;
+        while (std::getline(status, line)) {
+            if (line.compare(0, field.size(), field) == 0) {
+                return std::stol(line.substr(field.size()));
+            }
+        }
+        return 0;
+    }
+
+    long baseline = 0;
+#endif
+};
+
+} // namespace
+
+// The previous path: a rapidjson document, then a conversion to GeoJSON.
+static void Parse_GeoJSONDocument(benchmark::State& state) {
+    const Data data(state.range_x());
+    PeakRSS peakRSS;
+
+    while (state.KeepRunning()) {
+        JSDocument document;
+        document.Parse<0>(data.text.c_str());
+        style::conversion::Error error;
+        benchmark::DoNotOptimize(style::conversion::convertGeoJSON<JSValue>(document, error));
+    }
+
+    peakRSS.report(state, data.text.size());
+}
+
+static void Parse_GeoJSONText(benchmark::State& state) {
+    const Data data(state.range_x());
+    PeakRSS peakRSS;
+
+    while (state.KeepRunning()) {
+        benchmark::DoNotOptimize(util::parseGeoJSON(data.text));
+    }
+
+    peakRSS.report(state, data.text.size());
+}
+
+static void Parse_Geobuf(benchmark::State& state) {
+    const Data data(state.range_x());
+    PeakRSS peakRSS;
+
+    while (state.KeepRunning()) {
+        benchmark::DoNotOptimize(util::parseGeobuf(data.geobuf));
+    }
+
+    peakRSS.report(state, data.geobuf.size());
+}
+
+BENCHMARK(Parse_GeoJSONDocument)->Arg(1000)->Arg(10000);
+BENCHMARK(Parse_GeoJSONText)->Arg(1000)->Arg(10000);
+BENCHMARK(Parse_Geobuf)->Arg(1000)->Arg(10000);
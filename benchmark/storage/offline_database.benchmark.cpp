@@ -0,0 +1,71 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/storage/offline_database.hpp>
+#include <mbgl/storage/resource.hpp>
+#include <mbgl/storage/response.hpp>
+#include <mbgl/util/io.hpp>
+
+#include <sys/stat.h>
+
+using namespace mbgl;
+
+namespace {
+
+// A file rather than an in-memory database, so that each committed transaction pays for
+// syncing the journal and the database to disk, as it does on devices.
+const char* emptyDatabasePath() {
+    const char* path = "benchmark/fixtures/offline_database/offline.db";
+    mkdir("benchmark/fixtures/offline_database", 0755);
+    try {
+        util::deleteFile(path);
+    } catch (const util::IOException&) {
+    }
+    return path;
+}
+
+class OfflineDatabaseBenchmark {
+public:
+    OfflineDatabaseBenchmark() {
+        response.data = std::make_shared<std::string>(4096, 'x');
+    }
+
+    // Downloads of a region store each tile and link it to the region.
+    void putTile() {
+        db.putRegionResource(region.getID(), Resource::tile("http://example.com/{z}/{x}/{y}.pbf", 1.0,
+                                                            x++, 0, 22, Tileset::Scheme::XYZ), response);
+    }
+
+    OfflineDatabase db { emptyDatabasePath() };
+    OfflineRegion region = db.createRegion(
+        OfflineTilePyramidRegionDefinition("http://example.com/style.json", LatLngBounds::world(), 0, 22, 1.0),
+        OfflineRegionMetadata());
+    Response response;
+    int32_t x = 0;
+};
+
+} // namespace
+
+static void Storage_OfflineDatabasePutRegionResource(benchmark::State& state) {
+    OfflineDatabaseBenchmark bench;
+
+    while (state.KeepRunning()) {
+        bench.putTile();
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void Storage_OfflineDatabasePutRegionResourceBatched(benchmark::State& state) {
+    OfflineDatabaseBenchmark bench;
+    bench.db.beginBatch(state.range_x(), Seconds(60));
+
+    while (state.KeepRunning()) {
+        bench.putTile();
+    }
+
+    bench.db.endBatch();
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(Storage_OfflineDatabasePutRegionResource);
+BENCHMARK(Storage_OfflineDatabasePutRegionResourceBatched)->Arg(64)->Arg(512);
@@ -0,0 +1,87 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/util/image.hpp>
+#include <mbgl/util/io.hpp>
+#include <mbgl/util/premultiply.hpp>
+
+#include <cstring>
+
+using namespace mbgl;
+
+namespace {
+
+const char* fixtures[] = {
+    "test/fixtures/image/tile.png",
+    "test/fixtures/image/tile.jpeg",
+};
+
+} // namespace
+
+// The previous raster tile path: decode to premultiplied pixels, then unpremultiply them.
+static void Decode_RasterTileRoundTrip(benchmark::State& state) {
+    const std::string data = util::read_file(fixtures[state.range_x()]);
+
+    while (state.KeepRunning()) {
+        benchmark::DoNotOptimize(util::unpremultiply(decodeImage(data)));
+    }
+}
+
+static void Decode_RasterTileUnassociated(benchmark::State& state) {
+    const std::string data = util::read_file(fixtures[state.range_x()]);
+
+    while (state.KeepRunning()) {
+        benchmark::DoNotOptimize(decodeUnassociatedImage(data));
+    }
+}
+
+// A tile shown at half its resolution, e.g. a @2x tile at pixel ratio 1.
+static void Decode_RasterTileScaled(benchmark::State& state) {
+    const std::string data = util::read_file(fixtures[state.range_x()]);
+
+    while (state.KeepRunning()) {
+        benchmark::DoNotOptimize(decodeUnassociatedImage(data, { 128, 128 }));
+    }
+}
+
+// A 512×512 image with translucent pixels, so that no block takes the opaque shortcut.
+static UnassociatedImage translucentImage() {
+    UnassociatedImage image({ 512, 512 });
+    for (std::size_t i = 0; i < image.bytes(); i += 4) {
+        image.data[i + 0] = i % 251;
+        image.data[i + 1] = i % 241;
+        image.data[i + 2] = i % 239;
+        image.data[i + 3] = 1 + i % 254;
+    }
+    return image;
+}
+
+static void Util_Premultiply(benchmark::State& state) {
+    const UnassociatedImage source = translucentImage();
+    UnassociatedImage image = source.clone();
+
+    while (state.KeepRunning()) {
+        PremultipliedImage result = util::premultiply(std::move(image));
+        benchmark::DoNotOptimize(result.data.get());
+        image = { result.size, std::move(result.data) };
+        std::memcpy(image.data.get(), source.data.get(), source.bytes());
+    }
+}
+
+static void Util_Unpremultiply(benchmark::State& state) {
+    const UnassociatedImage source = translucentImage();
+    PremultipliedImage image = util::premultiply(source.clone());
+    const PremultipliedImage premultiplied = image.clone();
+
+    while (state.KeepRunning()) {
+        UnassociatedImage result = util::unpremultiply(std::move(image));
+        benchmark::DoNotOptimize(result.data.get());
+        image = { result.size, std::move(result.data) };
+        std::memcpy(image.data.get(), premultiplied.data.get(), premultiplied.bytes());
+    }
+}
+
+BENCHMARK(Decode_RasterTileRoundTrip)->Arg(0)->Arg(1);
+BENCHMARK(Decode_RasterTileUnassociated)->Arg(0)->Arg(1);
+BENCHMARK(Decode_RasterTileScaled)->Arg(0)->Arg(1);
+BENCHMARK(Util_Premultiply);
+BENCHMARK(Util_Unpremultiply);
@@ -0,0 +1,130 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/tile/vector_tile_data.hpp>
+#include <mbgl/geometry/feature_index.hpp>
+#include <mbgl/renderer/bucket.hpp>
+#include <mbgl/style/bucket_parameters.hpp>
+#include <mbgl/style/filter_evaluator.hpp>
+#include <mbgl/style/layers/line_layer.hpp>
+#include <mbgl/style/layers/line_layer_impl.hpp>
+#include <mbgl/util/io.hpp>
+
+using namespace mbgl;
+using namespace mbgl::style;
+
+namespace {
+
+// Lays out every source layer of a streets tile into line buckets, the same
+// way GeometryTileWorker::redoLayout does for each layer group.
+class LayoutBenchmark {
+public:
+    LayoutBenchmark() {
+        for (const auto& sourceLayer : { "landcover", "landuse", "water", "waterway",
+                                         "landuse_overlay", "road", "admin", "contour" }) {
+            auto layer = std::make_unique<LineLayer>(sourceLayer, "composite");
+            layer->setSourceLayer(sourceLayer);
+            layer->setFilter(NotEqualsFilter { "class", std::string("none") });
+            layers.push_back(std::move(layer));
+        }
+    }
+
+    template <class AddFeatures>
+    void layout(AddFeatures&& addFeatures) {
+        VectorTileData tileData(data);
+        FeatureIndex featureIndex;
+
+        for (const auto& layer : layers) {
+            const GeometryTileLayer* geometryLayer = tileData.getLayer(layer->getSourceLayer());
+            if (!geometryLayer) {
+                continue;
+            }
+
+            std::unique_ptr<Bucket> bucket = layer->baseImpl->createBucket(parameters, { layer.get() });
+            const Filter& filter = layer->baseImpl->filter;
+
+            addFeatures(*geometryLayer, [&] (std::size_t i, const GeometryTileFeature& feature) {
+                if (!filter(feature.getType(), feature.getID(), [&] (const auto& key) { return feature.getValue(key); }))
+                    return;
+
+                GeometryCollection geometries = feature.getGeometries();
+                bucket->addFeature(feature, geometries);
+                featureIndex.insert(geometries, i, layer->getSourceLayer(), layer->getID());
+            });
+
+            ::benchmark::DoNotOptimize(bucket->hasData());
+        }
+    }
+
+    const std::shared_ptr<const std::string> data = std::make_shared<std::string>(
+        util::read_file("test/fixtures/api/assets/streets/10-163-395.vector.pbf"));
+    const BucketParameters parameters { OverscaledTileID(10, 163, 395), MapMode::Continuous };
+    std::vector<std::unique_ptr<LineLayer>> layers;
+};
+
+} // end namespace
+
+// Allocates an owning feature per index, as layout did before eachFeature().
+static void Layout_VectorTileGetFeature(::benchmark::State& state) {
+    LayoutBenchmark bench;
+
+    while (state.KeepRunning()) {
+        bench.layout([] (const GeometryTileLayer& layer, const auto& add) {
+            for (std::size_t i = 0; i < layer.featureCount(); i++) {
+                std::unique_ptr<GeometryTileFeature> feature = layer.getFeature(i);
+                add(i, *feature);
+            }
+        });
+    }
+}
+
+static void Layout_VectorTileEachFeature(::benchmark::State& state) {
+    LayoutBenchmark bench;
+
+    while (state.KeepRunning()) {
+        bench.layout([] (const GeometryTileLayer& layer, const auto& add) {
+            layer.eachFeature([&] (std::size_t i, const GeometryTileFeature& feature) {
+                add(i, feature);
+                return true;
+            });
+        });
+    }
+}
+
+namespace {
+
+struct GeometryFixture {
+    const char* path;
+    std::vector<const char*> sourceLayers;
+};
+
+const GeometryFixture geometryFixtures[] = {
+    // Dense landcover, landuse and roads at z10.
+    { "test/fixtures/api/assets/streets/10-163-395.vector.pbf",
+      { "landcover", "hillshade", "contour", "landuse", "waterway", "water", "aeroway",
+        "landuse_overlay", "road", "admin" } },
+    // Large water polygons and many admin lines at z0.
+    { "test/fixtures/api/assets/streets/0-0-0.vector.pbf",
+      { "water", "admin" } },
+};
+
+} // end namespace
+
+// Decodes the geometry of every feature in a tile.
+static void Parse_VectorTileGeometries(::benchmark::State& state) {
+    const GeometryFixture& fixture = geometryFixtures[state.range_x()];
+    const std::shared_ptr<const std::string> data = std::make_shared<std::string>(util::read_file(fixture.path));
+
+    while (state.KeepRunning()) {
+        VectorTileData tileData(data);
+        for (const char* sourceLayer : fixture.sourceLayers) {
+            tileData.getLayer(sourceLayer)->eachFeature([&] (std::size_t, const GeometryTileFeature& feature) {
+                ::benchmark::DoNotOptimize(feature.getGeometries());
+                return true;
+            });
+        }
+    }
+}
+
+BENCHMARK(Layout_VectorTileGetFeature);
+BENCHMARK(Layout_VectorTileEachFeature);
+BENCHMARK(Parse_VectorTileGeometries)->Arg(0)->Arg(1);
@@ -1,6 +1,10 @@
 # Do not edit. Regenerate this with ./scripts/generate-benchmark-files.sh
 
 set(MBGL_BENCHMARK_FILES
+    # actor
+    benchmark/actor/mailbox.benchmark.cpp
+    benchmark/actor/scheduler.benchmark.cpp
+
     # api
     benchmark/api/query.benchmark.cpp
 
@@ -9,6 +13,7 @@ set(MBGL_BENCHMARK_FILES
 
     # parse
     benchmark/parse/filter.benchmark.cpp
+    benchmark/parse/geojson.benchmark.cpp
 
     # src
     benchmark/src/main.cpp
@@ -17,4 +22,11 @@ set(MBGL_BENCHMARK_FILES
     benchmark/src/mbgl/benchmark/benchmark.cpp
     benchmark/src/mbgl/benchmark/util.cpp
     benchmark/src/mbgl/benchmark/util.hpp
+
+    # storage
+    benchmark/storage/offline_database.benchmark.cpp
+
+    # tile
+    benchmark/tile/raster_tile.benchmark.cpp
+    benchmark/tile/vector_tile.benchmark.cpp
 )
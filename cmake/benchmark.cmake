@@ -19,6 +19,10 @@ target_link_libraries(mbgl-benchmark
 
 target_add_mason_package(mbgl-benchmark PRIVATE benchmark)
 target_add_mason_package(mbgl-benchmark PRIVATE rapidjson)
+target_add_mason_package(mbgl-benchmark PRIVATE geometry)
+target_add_mason_package(mbgl-benchmark PRIVATE variant)
+target_add_mason_package(mbgl-benchmark PRIVATE geojson)
+target_add_mason_package(mbgl-benchmark PRIVATE protozero)
 
 mbgl_platform_benchmark()
 
@@ -2,12 +2,18 @@
 
 set(MBGL_CORE_FILES
     # actor
+    include/mbgl/actor/instrumentation.hpp
     include/mbgl/actor/mailbox.hpp
     include/mbgl/actor/scheduler.hpp
     src/mbgl/actor/actor.hpp
     src/mbgl/actor/actor_ref.hpp
+    src/mbgl/actor/instrumentation.cpp
     src/mbgl/actor/mailbox.cpp
     src/mbgl/actor/message.hpp
+    src/mbgl/actor/message_pool.cpp
+    src/mbgl/actor/message_pool.hpp
+    src/mbgl/actor/parallel_for.cpp
+    src/mbgl/actor/parallel_for.hpp
 
     # algorithm
     src/mbgl/algorithm/covered_by_children.hpp
@@ -106,6 +112,7 @@ set(MBGL_CORE_FILES
     include/mbgl/map/change.hpp
     include/mbgl/map/map.hpp
     include/mbgl/map/map_observer.hpp
+    include/mbgl/map/memory_usage.hpp
     include/mbgl/map/mode.hpp
     include/mbgl/map/query.hpp
     include/mbgl/map/view.hpp
@@ -257,6 +264,8 @@ set(MBGL_CORE_FILES
     src/mbgl/style/cascade_parameters.hpp
     src/mbgl/style/class_dictionary.cpp
     src/mbgl/style/class_dictionary.hpp
+    src/mbgl/style/compiled_filter.cpp
+    src/mbgl/style/compiled_filter.hpp
     src/mbgl/style/cross_faded_property_evaluator.cpp
     src/mbgl/style/cross_faded_property_evaluator.hpp
     src/mbgl/style/data_driven_property_evaluator.hpp
@@ -374,6 +383,8 @@ set(MBGL_CORE_FILES
     src/mbgl/style/sources/geojson_source.cpp
     src/mbgl/style/sources/geojson_source_impl.cpp
     src/mbgl/style/sources/geojson_source_impl.hpp
+    src/mbgl/style/sources/geojson_source_worker.cpp
+    src/mbgl/style/sources/geojson_source_worker.hpp
     src/mbgl/style/sources/raster_source.cpp
     src/mbgl/style/sources/raster_source_impl.cpp
     src/mbgl/style/sources/raster_source_impl.hpp
@@ -410,6 +421,10 @@ set(MBGL_CORE_FILES
     # tile
     src/mbgl/tile/geojson_tile.cpp
     src/mbgl/tile/geojson_tile.hpp
+    src/mbgl/tile/geometry_cache.cpp
+    src/mbgl/tile/geometry_cache.hpp
+    src/mbgl/tile/geometry_decoder.cpp
+    src/mbgl/tile/geometry_decoder.hpp
     src/mbgl/tile/geometry_tile.cpp
     src/mbgl/tile/geometry_tile.hpp
     src/mbgl/tile/geometry_tile_data.cpp
@@ -431,6 +446,8 @@ set(MBGL_CORE_FILES
     src/mbgl/tile/tile_observer.hpp
     src/mbgl/tile/vector_tile.cpp
     src/mbgl/tile/vector_tile.hpp
+    src/mbgl/tile/vector_tile_data.cpp
+    src/mbgl/tile/vector_tile_data.hpp
 
     # util
     include/mbgl/util/async_request.hpp
@@ -483,7 +500,11 @@ set(MBGL_CORE_FILES
     src/mbgl/util/exclusive.hpp
     src/mbgl/util/font_stack.cpp
     src/mbgl/util/geo.cpp
+    src/mbgl/util/geobuf_reader.cpp
+    src/mbgl/util/geobuf_reader.hpp
     src/mbgl/util/geojson.cpp
+    src/mbgl/util/geojson_reader.cpp
+    src/mbgl/util/geojson_reader.hpp
     src/mbgl/util/grid_index.cpp
     src/mbgl/util/grid_index.hpp
     src/mbgl/util/http_header.cpp
@@ -492,6 +513,7 @@ set(MBGL_CORE_FILES
     src/mbgl/util/http_timeout.hpp
     src/mbgl/util/i18n.cpp
     src/mbgl/util/i18n.hpp
+    src/mbgl/util/image_scale.hpp
     src/mbgl/util/indexed_tuple.hpp
     src/mbgl/util/interpolate.cpp
     src/mbgl/util/intersection_tests.cpp
@@ -4,6 +4,9 @@ set(MBGL_TEST_FILES
     # actor
     test/actor/actor.test.cpp
     test/actor/actor_ref.test.cpp
+    test/actor/instrumentation.test.cpp
+    test/actor/message_pool.test.cpp
+    test/actor/parallel_for.test.cpp
 
     # algorithm
     test/algorithm/covered_by_children.test.cpp
@@ -106,8 +109,11 @@ set(MBGL_TEST_FILES
     # tile
     test/tile/annotation_tile.test.cpp
     test/tile/geojson_tile.test.cpp
+    test/tile/geometry_cache.test.cpp
+    test/tile/geometry_decoder.test.cpp
     test/tile/geometry_tile_data.test.cpp
     test/tile/raster_tile.test.cpp
+    test/tile/tile_cache.test.cpp
     test/tile/tile_coordinate.test.cpp
     test/tile/tile_id.test.cpp
     test/tile/vector_tile.test.cpp
@@ -115,6 +121,8 @@ set(MBGL_TEST_FILES
     # util
     test/util/async_task.test.cpp
     test/util/geo.test.cpp
+    test/util/geobuf_reader.test.cpp
+    test/util/geojson_reader.test.cpp
     test/util/http_timeout.test.cpp
     test/util/image.test.cpp
     test/util/mapbox.test.cpp
@@ -132,4 +140,5 @@ set(MBGL_TEST_FILES
     test/util/token.test.cpp
     test/util/url.test.cpp
     test/util/work_queue.test.cpp
+    test/util/work_stealing_thread_pool.test.cpp
 )
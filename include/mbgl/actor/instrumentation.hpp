@@ -0,0 +1,79 @@
+#pragma once
+
+#include <mbgl/util/chrono.hpp>
+#include <mbgl/util/noncopyable.hpp>
+
+#include <array>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <typeindex>
+#include <unordered_map>
+
+namespace mbgl {
+namespace actor {
+
+// A histogram of durations with logarithmic buckets: bucket 0 counts durations below 1µs,
+// and bucket i counts durations in [2^(i-1), 2^i) µs. The last bucket also counts anything
+// longer than that.
+class Histogram {
+public:
+    static constexpr std::size_t bucketCount = 32;
+
+    std::array<std::size_t, bucketCount> buckets {{}};
+    std::size_t count = 0;
+    Duration total = Duration::zero();
+    Duration max = Duration::zero();
+
+    Duration mean() const;
+
+    // Returns an upper bound for the given percentile (0-100), with bucket resolution.
+    Duration percentile(double) const;
+};
+
+class ActorStatistics {
+public:
+    // Number of messages received.
+    std::size_t messages = 0;
+
+    // Number of messages waiting in the mailbox, sampled whenever a message is sent.
+    std::size_t maxQueueLength = 0;
+    double meanQueueLength = 0;
+
+    // Time between a mailbox being scheduled and a thread starting to receive from it.
+    Histogram waitTime;
+
+    // Time spent processing each message.
+    Histogram executionTime;
+};
+
+/*
+    Opt-in instrumentation for actors. When a `Scheduler` returns an `Instrumentation` from
+    `getInstrumentation()`, every mailbox of an actor created on that scheduler from then on
+    records its statistics here, grouped by the class of the actor (e.g. `GeometryTileWorker`).
+    Recording only uses atomic operations; no lock is taken once a mailbox has been created.
+*/
+class Instrumentation : private util::noncopyable {
+public:
+    class Entry;
+
+    Instrumentation();
+    ~Instrumentation();
+
+    Entry& entry(const std::type_info&);
+
+    static void recordQueueLength(Entry&, std::size_t);
+    static void recordWaitTime(Entry&, Duration);
+    static void recordExecutionTime(Entry&, Duration);
+
+    // Returns the statistics collected so far, keyed by actor class name.
+    std::map<std::string, ActorStatistics> snapshot() const;
+
+private:
+    mutable std::mutex mutex;
+    std::unordered_map<std::type_index, std::unique_ptr<Entry>> entries;
+};
+
+} // namespace actor
+} // namespace mbgl
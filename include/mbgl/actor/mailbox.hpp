@@ -1,33 +1,82 @@
 #pragma once
 
+#include <mbgl/actor/scheduler.hpp>
+#include <mbgl/actor/instrumentation.hpp>
+#include <mbgl/util/chrono.hpp>
+
+#include <atomic>
+#include <condition_variable>
 #include <memory>
 #include <mutex>
-#include <queue>
 
 namespace mbgl {
 
-class Scheduler;
 class Message;
 
+// Bounds the work done by a single call to `Mailbox::receive()`: it returns after `maxMessages`
+// messages or once `maxDuration` has elapsed, whichever comes first, but always receives at
+// least one message. The mailbox is then rescheduled behind the ones that are already waiting,
+// so that a busy mailbox can't starve the others.
+class ReceiveQuantum {
+public:
+    std::size_t maxMessages = 1;
+    Duration maxDuration = Duration::max();
+};
+
 class Mailbox : public std::enable_shared_from_this<Mailbox> {
 public:
     Mailbox(Scheduler&);
 
+    // Creates a mailbox for an actor of the given class, which is used to group
+    // statistics when the scheduler is instrumented.
+    Mailbox(Scheduler&, const std::type_info&);
+    ~Mailbox();
+
     void push(std::unique_ptr<Message>);
 
+    // Changes the priority with which this mailbox is scheduled. If it is already waiting
+    // in the scheduler, raising the priority takes effect immediately.
+    void setPriority(Scheduler::Priority);
+
     void close();
-    void receive();
+    void receive(const ReceiveQuantum& = {});
 
-    static void maybeReceive(std::weak_ptr<Mailbox>);
+    static void maybeReceive(std::weak_ptr<Mailbox>, const ReceiveQuantum& = {});
 
 private:
+    void schedule();
+    Message* pop();
+
     Scheduler& scheduler;
 
+    // Only set if the scheduler is instrumented.
+    actor::Instrumentation::Entry* const statistics;
+    TimePoint scheduledAt;
+
+    std::atomic<Scheduler::Priority> priority { Scheduler::Priority::Normal };
+
+    // Set while the mailbox is waiting in the scheduler. When the priority is raised, the
+    // mailbox is scheduled a second time; whichever entry runs first clears the flag, so
+    // that the other one is ignored.
+    std::atomic<bool> queued { false };
+
+    // `receive()` doesn't take a lock; `close()` only waits on the condition
+    // variable while a message is being processed.
+    std::atomic<bool> closing { false };
+    // A counter rather than a flag: once a message has been taken off the queue, the next
+    // receive() may start on another thread before this one has returned.
+    std::atomic<std::size_t> receiving { 0 };
     std::mutex closingMutex;
-    bool closing { false };
+    std::condition_variable closingCondition;
 
-    std::mutex queueMutex;
-    std::queue<std::unique_ptr<Message>> queue;
+    // Intrusive multi-producer/single-consumer queue. Producers push at `head`;
+    // the consumer, i.e. whichever thread is running `receive()`, pops at `tail`.
+    // `size` counts pushed messages that haven't been received yet, and is used
+    // to schedule the mailbox once when it goes from empty to non-empty.
+    const std::unique_ptr<Message> stub;
+    std::atomic<Message*> head;
+    Message* tail;
+    std::atomic<std::size_t> size { 0 };
 };
 
 } // namespace mbgl
@@ -1,11 +1,16 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
 
 namespace mbgl {
 
 class Mailbox;
 
+namespace actor {
+class Instrumentation;
+} // namespace actor
+
 /*
     A `Scheduler` is responsible for coordinating the processing of messages by
     one or more actors via their mailboxes. It's an abstract interface. Currently,
@@ -21,18 +26,41 @@ class Mailbox;
       Subject to these constraints, processing can happen on whatever thread in the
       pool is available.
 
+    * `WorkStealingThreadPool` provides the same guarantees as `ThreadPool`, but gives each
+      thread its own queue and lets idle threads steal work from busy ones. It scales better
+      on machines with many cores.
+
     * `RunLoop` is a `Scheduler` that is typically used to create a mailbox and
       `ActorRef` for an object that lives on the main thread and is not itself wrapped
       as an `Actor`:
 
         auto mailbox = std::make_shared<Mailbox>(*util::RunLoop::Get());
         Actor<Worker> worker(threadPool, ActorRef<Foo>(*this, mailbox));
+
+    Each mailbox has a `Priority`. Schedulers that support priorities process mailboxes with
+    a higher priority first; others process all mailboxes alike.
 */
 
 class Scheduler {
 public:
+    enum class Priority : uint8_t {
+        Low,
+        Normal,
+        High,
+    };
+
     virtual ~Scheduler() = default;
     virtual void schedule(std::weak_ptr<Mailbox>) = 0;
+
+    virtual void scheduleWithPriority(std::weak_ptr<Mailbox> mailbox, Priority) {
+        schedule(std::move(mailbox));
+    }
+
+    // Returns the instrumentation that actors created on this scheduler record their
+    // statistics to, or nullptr when instrumentation is disabled (the default).
+    virtual actor::Instrumentation* getInstrumentation() {
+        return nullptr;
+    }
 };
 
 } // namespace mbgl
@@ -12,6 +12,7 @@
 #include <mbgl/style/transition_options.hpp>
 #include <mbgl/map/camera.hpp>
 #include <mbgl/map/query.hpp>
+#include <mbgl/map/memory_usage.hpp>
 
 #include <cstdint>
 #include <string>
@@ -192,8 +193,18 @@ public:
 
     // Memory
     void setSourceTileCacheSize(size_t);
+
+    // Limits the memory used by the tiles that each source keeps cached for reuse, or with
+    // `shared`, by the tiles of all sources together; the least recently used tiles are
+    // evicted first. With a limit of zero, each source caches about as many tiles as the
+    // visible zoom range needs.
+    void setSourceTileCacheBytes(std::size_t bytes, bool shared = false);
     void onLowMemory();
 
+    // The memory used by the sources, layers and atlases of the style, and by the buffers and
+    // textures of the renderer.
+    MapMemoryUsage getMemoryUsage() const;
+
     // Debug
     void setDebug(MapDebugOptions);
     void cycleDebugOptions();
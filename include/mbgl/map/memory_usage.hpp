@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+
+namespace mbgl {
+
+/**
+ * Memory in bytes, split between the CPU side (vectors, images and indexes held by
+ * the map) and the GPU side (buffers and textures uploaded from them).
+ */
+class MemoryUsage {
+public:
+    std::size_t cpu = 0;
+    std::size_t gpu = 0;
+
+    std::size_t total() const {
+        return cpu + gpu;
+    }
+
+    MemoryUsage& operator+=(const MemoryUsage& other) {
+        cpu += other.cpu;
+        gpu += other.gpu;
+        return *this;
+    }
+
+    friend MemoryUsage operator+(MemoryUsage lhs, const MemoryUsage& rhs) {
+        return lhs += rhs;
+    }
+};
+
+/**
+ * The memory used by the map, broken down by source and by layer.
+ */
+class MapMemoryUsage {
+public:
+    /** The tiles of each source, in use or cached: their data, feature indexes, collision
+        tiles and buckets. */
+    std::unordered_map<std::string, MemoryUsage> sources;
+
+    /** The buckets of each layer. Layers with the same layout share their buckets, which
+        are then counted for each of them. */
+    std::unordered_map<std::string, MemoryUsage> layers;
+
+    MemoryUsage glyphAtlas;
+    MemoryUsage spriteAtlas;
+    MemoryUsage lineAtlas;
+
+    /** The sources and the atlases together. */
+    MemoryUsage total;
+
+    /** All buffers and textures created by the renderer, including its own. */
+    std::size_t bufferBytes = 0;
+    std::size_t textureBytes = 0;
+};
+
+} // namespace mbgl
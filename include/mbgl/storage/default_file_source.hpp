@@ -115,6 +115,15 @@ public:
      */
     void setOfflineMapboxTileCountLimit(uint64_t) const;
 
+    /*
+     * Register a codec for the resources stored in the database under `id`, which must be
+     * above `OfflineCodec::Zlib`, and compress the resources of the given kinds with it from
+     * now on. Resources stored with a codec that isn't registered are treated as missing, so
+     * the codec must be registered again every time the database is opened. It applies to
+     * the requests made once this method returns.
+     */
+    void addOfflineCodec(uint8_t id, std::shared_ptr<OfflineCodec>, std::vector<Resource::Kind> = {});
+
     /*
      * Pause file request activity.
      *
@@ -137,7 +146,10 @@ public:
     class Impl;
 
 private:
+    class ReadImpl;
+
     const std::unique_ptr<util::Thread<Impl>> thread;
+    const std::unique_ptr<util::Thread<ReadImpl>> readThread;
     const std::unique_ptr<FileSource> assetFileSource;
     const std::unique_ptr<FileSource> localFileSource;
     std::string cachedBaseURL = mbgl::util::API_BASE_URL;
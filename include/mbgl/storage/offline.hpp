@@ -181,6 +181,26 @@ public:
     virtual void mapboxTileCountLimitExceeded(uint64_t /* limit */) {}
 };
 
+/*
+ * Compresses the resources stored in the offline database. Each stored resource records
+ * the identifier of the codec that compressed it: `Uncompressed` if it is stored as is,
+ * or `Zlib` for the built-in codec, which compresses all resources by default. Databases
+ * written before codecs were pluggable only contain these two. Other codecs use
+ * identifiers above `Zlib`.
+ *
+ * A codec may be called from several threads at once.
+ */
+class OfflineCodec {
+public:
+    virtual ~OfflineCodec() = default;
+
+    virtual std::string compress(const std::string&) = 0;
+    virtual std::string decompress(const std::string&) = 0;
+
+    static constexpr uint8_t Uncompressed = 0;
+    static constexpr uint8_t Zlib = 1;
+};
+
 class OfflineRegion {
 public:
     // Move-only; not publicly constructible.
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <mbgl/style/source.hpp>
+#include <mbgl/util/feature.hpp>
 #include <mbgl/util/geojson.hpp>
 #include <mbgl/util/optional.hpp>
 
@@ -36,6 +37,15 @@ struct GeoJSONOptions {
     uint8_t clusterMaxZoom = 17;
 };
 
+// Changes to the features of a GeoJSONSource, matched by feature id.
+struct GeoJSONSourceDiff {
+    // Features to add, or to replace the existing features with the same id.
+    mapbox::geometry::feature_collection<double> update;
+
+    // Ids of features to remove.
+    std::vector<FeatureIdentifier> remove;
+};
+
 class GeoJSONSource : public Source {
 public:
     GeoJSONSource(const std::string& id, const GeoJSONOptions options_ = GeoJSONOptions());
@@ -43,6 +53,14 @@ public:
     void setURL(const std::string& url);
     void setGeoJSON(const GeoJSON&);
 
+    // Sets the data from Geobuf, a compact binary encoding of GeoJSON. Sources loaded from a
+    // URL accept Geobuf as well as GeoJSON text.
+    void setGeobuf(std::string);
+
+    // Applies changes to the current data. Only tiles that contain changed features, at
+    // their old or new position, are reloaded.
+    void updateGeoJSON(const GeoJSONSourceDiff&);
+
     optional<std::string> getURL() const;
 
     // Private implementation
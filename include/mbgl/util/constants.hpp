@@ -40,11 +40,20 @@ constexpr float  MAX_ZOOM_F = MAX_ZOOM;
 
 constexpr uint64_t DEFAULT_MAX_CACHE_SIZE = 50 * 1024 * 1024;
 
+// Batched offline database writes are committed after this many writes, or once their
+// transaction has been open this long, whichever comes first.
+constexpr std::size_t DEFAULT_OFFLINE_BATCH_SIZE = 512;
+constexpr Duration DEFAULT_OFFLINE_BATCH_DURATION = Seconds(1);
+
 constexpr Duration DEFAULT_FADE_DURATION = Milliseconds(300);
 constexpr Seconds CLOCK_SKEW_RETRY_TIMEOUT { 30 };
 
 constexpr UnitBezier DEFAULT_TRANSITION_EASE = { 0, 0, 0.25, 1 };
 
+// The number of camera states along an animation, including its destination, for which tiles
+// are prefetched.
+constexpr std::size_t PREFETCH_SAMPLES = 4;
+
 constexpr int DEFAULT_RATE_LIMIT_TIMEOUT = 5;
 
 constexpr const char* API_BASE_URL = "https://api.mapbox.com";
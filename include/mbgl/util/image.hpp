@@ -126,6 +126,15 @@ using AlphaImage = Image<ImageAlphaMode::Exclusive>;
 
 // TODO: don't use std::string for binary data.
 PremultipliedImage decodeImage(const std::string&);
+
+// Decodes an image without premultiplying it, for consumers that need unassociated alpha.
+// Where the platform decoders produce unassociated alpha, this skips the round trip.
+//
+// When `targetSize` is given, decoders that support scaled decoding (JPEG and WebP on
+// the default platform) reduce the image by a power of two while keeping it at least that
+// large. Other images are decoded at full resolution.
+UnassociatedImage decodeUnassociatedImage(const std::string&, Size targetSize = {});
+
 std::string encodePNG(const PremultipliedImage&);
 
 } // namespace mbgl
@@ -1,4 +1,5 @@
 #include <mbgl/util/image+MGLAdditions.hpp>
+#include <mbgl/util/premultiply.hpp>
 
 #import <ImageIO/ImageIO.h>
 
@@ -83,7 +84,7 @@ mbgl::PremultipliedImage MGLPremultipliedImageFromCGImage(CGImageRef src) {
 
 namespace mbgl {
 
-PremultipliedImage decodeImage(const std::string& source) {
+static CGImageRef decodeCGImage(const std::string& source) {
     CFDataHandle data(CFDataCreateWithBytesNoCopy(
         kCFAllocatorDefault, reinterpret_cast<const unsigned char*>(source.data()), source.size(),
         kCFAllocatorNull));
@@ -96,12 +97,33 @@ PremultipliedImage decodeImage(const std::string& source) {
         throw std::runtime_error("CGImageSourceCreateWithData failed");
     }
 
-    CGImageHandle image(CGImageSourceCreateImageAtIndex(*imageSource, 0, NULL));
+    CGImageRef image = CGImageSourceCreateImageAtIndex(*imageSource, 0, NULL);
     if (!image) {
         throw std::runtime_error("CGImageSourceCreateImageAtIndex failed");
     }
 
+    return image;
+}
+
+PremultipliedImage decodeImage(const std::string& source) {
+    CGImageHandle image(decodeCGImage(source));
     return MGLPremultipliedImageFromCGImage(*image);
 }
 
+// Bitmap contexts only draw premultiplied pixels, so images with alpha are unpremultiplied
+// again; opaque images are the same in either mode. Images are decoded at full resolution.
+UnassociatedImage decodeUnassociatedImage(const std::string& source, Size) {
+    CGImageHandle image(decodeCGImage(source));
+    PremultipliedImage premultiplied = MGLPremultipliedImageFromCGImage(*image);
+
+    switch (CGImageGetAlphaInfo(*image)) {
+    case kCGImageAlphaNone:
+    case kCGImageAlphaNoneSkipFirst:
+    case kCGImageAlphaNoneSkipLast:
+        return { premultiplied.size, std::move(premultiplied.data) };
+    default:
+        return util::unpremultiply(std::move(premultiplied));
+    }
+}
+
 } // namespace mbgl
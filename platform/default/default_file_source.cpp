@@ -24,6 +24,59 @@ bool isAssetURL(const std::string& url) {
 
 namespace mbgl {
 
+namespace {
+
+// Whether the cache is consulted before the network, or instead of it for optional requests.
+bool needsCacheLookup(const Resource& resource) {
+    const bool hasPrior = resource.priorEtag || resource.priorModified || resource.priorExpires;
+    return !hasPrior || resource.necessity == Resource::Optional;
+}
+
+// Returns the response to send for a cache lookup, if any.
+optional<Response> cacheLookupResponse(const Resource& resource, optional<Response> offlineResponse) {
+    if (resource.necessity == Resource::Optional && !offlineResponse) {
+        // Ensure there's always a response that we can send, so the caller knows that
+        // there's no optional data available in the cache.
+        offlineResponse.emplace();
+        offlineResponse->noContent = true;
+        offlineResponse->error = std::make_unique<Response::Error>(
+            Response::Error::Reason::NotFound, "Not found in offline database");
+    }
+    return offlineResponse;
+}
+
+// Returns the resource to request from the network to revalidate a cached response.
+Resource revalidationResource(Resource resource, const optional<Response>& offlineResponse) {
+    if (offlineResponse) {
+        resource.priorModified = offlineResponse->modified;
+        resource.priorExpires = offlineResponse->expires;
+        resource.priorEtag = offlineResponse->etag;
+    }
+    return resource;
+}
+
+} // namespace
+
+// Reads from the cache with a connection of its own, on a thread of its own, so that cache
+// lookups don't wait for the writes that happen on the database thread, like offline downloads.
+class DefaultFileSource::ReadImpl {
+public:
+    ReadImpl(const std::string& cachePath)
+        : offlineDatabase(cachePath, OfflineDatabase::ReadOnly()) {
+    }
+
+    void get(const Resource& resource, std::function<void (optional<Response>)> callback) {
+        callback(offlineDatabase.get(resource));
+    }
+
+    void addCodec(uint8_t id, std::shared_ptr<OfflineCodec> codec) {
+        offlineDatabase.addCodec(id, std::move(codec));
+    }
+
+private:
+    OfflineDatabase offlineDatabase;
+};
+
 class DefaultFileSource::Impl {
 public:
     Impl(const std::string& cachePath, uint64_t maximumCacheSize)
@@ -107,28 +160,20 @@ public:
     void request(AsyncRequest* req, Resource resource, Callback callback) {
         Resource revalidation = resource;
 
-        const bool hasPrior = resource.priorEtag || resource.priorModified || resource.priorExpires;
-        if (!hasPrior || resource.necessity == Resource::Optional) {
-            auto offlineResponse = offlineDatabase.get(resource);
-
-            if (resource.necessity == Resource::Optional && !offlineResponse) {
-                // Ensure there's always a response that we can send, so the caller knows that
-                // there's no optional data available in the cache.
-                offlineResponse.emplace();
-                offlineResponse->noContent = true;
-                offlineResponse->error = std::make_unique<Response::Error>(
-                    Response::Error::Reason::NotFound, "Not found in offline database");
-            }
-
+        if (needsCacheLookup(resource)) {
+            auto offlineResponse = cacheLookupResponse(resource, offlineDatabase.get(resource));
             if (offlineResponse) {
-                revalidation.priorModified = offlineResponse->modified;
-                revalidation.priorExpires = offlineResponse->expires;
-                revalidation.priorEtag = offlineResponse->etag;
+                revalidation = revalidationResource(resource, offlineResponse);
                 callback(*offlineResponse);
             }
         }
 
-        if (resource.necessity == Resource::Required) {
+        requestOnline(req, revalidation, callback);
+    }
+
+    // Continues a request whose cache lookup has been done on the reader thread.
+    void requestOnline(AsyncRequest* req, Resource revalidation, Callback callback) {
+        if (revalidation.necessity == Resource::Required) {
             tasks[req] = onlineFileSource.request(revalidation, [=] (Response onlineResponse) {
                 this->offlineDatabase.put(revalidation, onlineResponse);
                 callback(onlineResponse);
@@ -140,10 +185,21 @@ public:
         tasks.erase(req);
     }
 
+    void markAccessed(const Resource& resource) {
+        offlineDatabase.markAccessed(resource);
+    }
+
     void setOfflineMapboxTileCountLimit(uint64_t limit) {
         offlineDatabase.setOfflineMapboxTileCountLimit(limit);
     }
 
+    void addCodec(uint8_t id, std::shared_ptr<OfflineCodec> codec, const std::vector<Resource::Kind>& kinds) {
+        offlineDatabase.addCodec(id, std::move(codec));
+        for (auto kind : kinds) {
+            offlineDatabase.useCodec(kind, id);
+        }
+    }
+
     void put(const Resource& resource, const Response& response) {
         offlineDatabase.put(resource, response);
     }
@@ -169,6 +225,9 @@ DefaultFileSource::DefaultFileSource(const std::string& cachePath,
                                      uint64_t maximumCacheSize)
     : thread(std::make_unique<util::Thread<Impl>>(util::ThreadContext{"DefaultFileSource", util::ThreadPriority::Low},
             cachePath, maximumCacheSize)),
+      // Each connection to an in-memory database has a database of its own.
+      readThread(cachePath == ":memory:" ? nullptr :
+          std::make_unique<util::Thread<ReadImpl>>(util::ThreadContext{"DefaultFileSourceReader"}, cachePath)),
       assetFileSource(std::make_unique<AssetFileSource>(assetRoot)),
       localFileSource(std::make_unique<LocalFileSource>()) {
 }
@@ -205,9 +264,30 @@ void DefaultFileSource::setResourceTransform(std::function<std::string(Resource:
 std::unique_ptr<AsyncRequest> DefaultFileSource::request(const Resource& resource, Callback callback) {
     class DefaultFileRequest : public AsyncRequest {
     public:
-        DefaultFileRequest(Resource resource_, FileSource::Callback callback_, util::Thread<DefaultFileSource::Impl>& thread_)
-            : thread(thread_),
-              workRequest(thread.invokeWithCallback(&DefaultFileSource::Impl::request, this, resource_, callback_)) {
+        DefaultFileRequest(Resource resource_, FileSource::Callback callback_,
+                           util::Thread<DefaultFileSource::Impl>& thread_,
+                           util::Thread<DefaultFileSource::ReadImpl>* readThread)
+            : thread(thread_) {
+            if (!readThread || !needsCacheLookup(resource_)) {
+                workRequest = thread.invokeWithCallback(&DefaultFileSource::Impl::request, this, resource_, callback_);
+                return;
+            }
+
+            readRequest = readThread->invokeWithCallback(&DefaultFileSource::ReadImpl::get, resource_,
+                [this, resource_, callback_] (optional<Response> cached) {
+                    if (cached) {
+                        thread.invoke(&DefaultFileSource::Impl::markAccessed, resource_);
+                    }
+
+                    auto offlineResponse = cacheLookupResponse(resource_, std::move(cached));
+                    workRequest = thread.invokeWithCallback(&DefaultFileSource::Impl::requestOnline, this,
+                        revalidationResource(resource_, offlineResponse), callback_);
+
+                    // This may delete the request, so it must come last.
+                    if (offlineResponse) {
+                        callback_(*offlineResponse);
+                    }
+                });
         }
 
         ~DefaultFileRequest() override {
@@ -215,6 +295,7 @@ std::unique_ptr<AsyncRequest> DefaultFileSource::request(const Resource& resourc
         }
 
         util::Thread<DefaultFileSource::Impl>& thread;
+        std::unique_ptr<AsyncRequest> readRequest;
         std::unique_ptr<AsyncRequest> workRequest;
     };
 
@@ -223,7 +304,7 @@ std::unique_ptr<AsyncRequest> DefaultFileSource::request(const Resource& resourc
     } else if (LocalFileSource::acceptsURL(resource.url)) {
         return localFileSource->request(resource, callback);
     } else {
-        return std::make_unique<DefaultFileRequest>(resource, callback, *thread);
+        return std::make_unique<DefaultFileRequest>(resource, callback, *thread, readThread.get());
     }
 }
 
@@ -263,12 +344,26 @@ void DefaultFileSource::setOfflineMapboxTileCountLimit(uint64_t limit) const {
     thread->invokeSync(&Impl::setOfflineMapboxTileCountLimit, limit);
 }
 
+void DefaultFileSource::addOfflineCodec(uint8_t id, std::shared_ptr<OfflineCodec> codec, std::vector<Resource::Kind> kinds) {
+    // Both connections decode what the other one may have stored with the codec.
+    if (readThread) {
+        readThread->invokeSync(&ReadImpl::addCodec, id, codec);
+    }
+    thread->invokeSync(&Impl::addCodec, id, codec, kinds);
+}
+
 void DefaultFileSource::pause() {
     thread->pause();
+    if (readThread) {
+        readThread->pause();
+    }
 }
 
 void DefaultFileSource::resume() {
     thread->resume();
+    if (readThread) {
+        readThread->resume();
+    }
 }
 
 // For testing only:
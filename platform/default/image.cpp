@@ -1,17 +1,21 @@
 #include <mbgl/util/image.hpp>
 #include <mbgl/util/string.hpp>
-#include <mbgl/util/premultiply.hpp>
 
 namespace mbgl {
 
 #if !defined(__ANDROID__) && !defined(__APPLE__)
-PremultipliedImage decodeWebP(const uint8_t*, size_t);
+template <ImageAlphaMode Mode>
+Image<Mode> decodeWebP(const uint8_t*, size_t, Size targetSize);
 #endif // !defined(__ANDROID__) && !defined(__APPLE__)
 
-PremultipliedImage decodePNG(const uint8_t*, size_t);
-PremultipliedImage decodeJPEG(const uint8_t*, size_t);
+template <ImageAlphaMode Mode>
+Image<Mode> decodePNG(const uint8_t*, size_t);
+template <ImageAlphaMode Mode>
+Image<Mode> decodeJPEG(const uint8_t*, size_t, Size targetSize);
 
-PremultipliedImage decodeImage(const std::string& string) {
+// The decoders produce the requested alpha mode directly.
+template <ImageAlphaMode Mode>
+static Image<Mode> decode(const std::string& string, Size targetSize) {
     const uint8_t* data = reinterpret_cast<const uint8_t*>(string.data());
     const size_t size = string.size();
 
@@ -20,7 +24,7 @@ PremultipliedImage decodeImage(const std::string& string) {
         uint32_t riff_magic = (data[0] << 24) | (data[1] << 16) | (data[2] << 8) | data[3];
         uint32_t webp_magic = (data[8] << 24) | (data[9] << 16) | (data[10] << 8) | data[11];
         if (riff_magic == 0x52494646 && webp_magic == 0x57454250) {
-            return decodeWebP(data, size);
+            return decodeWebP<Mode>(data, size, targetSize);
         }
     }
 #endif // !defined(__ANDROID__) && !defined(__APPLE__)
@@ -28,18 +32,26 @@ PremultipliedImage decodeImage(const std::string& string) {
     if (size >= 4) {
         uint32_t magic = (data[0] << 24) | (data[1] << 16) | (data[2] << 8) | data[3];
         if (magic == 0x89504E47U) {
-            return decodePNG(data, size);
+            return decodePNG<Mode>(data, size);
         }
     }
 
     if (size >= 2) {
         uint16_t magic = ((data[0] << 8) | data[1]) & 0xffff;
         if (magic == 0xFFD8) {
-            return decodeJPEG(data, size);
+            return decodeJPEG<Mode>(data, size, targetSize);
         }
     }
 
     throw std::runtime_error("unsupported image type");
 }
 
+PremultipliedImage decodeImage(const std::string& string) {
+    return decode<ImageAlphaMode::Premultiplied>(string, {});
+}
+
+UnassociatedImage decodeUnassociatedImage(const std::string& string, Size targetSize) {
+    return decode<ImageAlphaMode::Unassociated>(string, targetSize);
+}
+
 } // namespace mbgl
@@ -1,5 +1,6 @@
 #include <mbgl/util/image.hpp>
 #include <mbgl/util/char_array_buffer.hpp>
+#include <mbgl/util/image_scale.hpp>
 
 #include <istream>
 #include <sstream>
@@ -89,7 +90,10 @@ struct jpeg_info_guard {
     jpeg_decompress_struct* i_;
 };
 
-PremultipliedImage decodeJPEG(const uint8_t* data, size_t size) {
+// JPEG images are opaque, so they are the same with either alpha mode. Images larger than
+// `targetSize` are reduced while they are decoded, with libjpeg's DCT scaling.
+template <ImageAlphaMode Mode>
+Image<Mode> decodeJPEG(const uint8_t* data, size_t size, Size targetSize) {
     util::CharArrayBuffer dataBuffer { reinterpret_cast<const char*>(data), size };
     std::istream stream(&dataBuffer);
 
@@ -106,6 +110,9 @@ PremultipliedImage decodeJPEG(const uint8_t* data, size_t size) {
     if (ret != JPEG_HEADER_OK)
         throw std::runtime_error("JPEG Reader: failed to read header");
 
+    cinfo.scale_num = 1;
+    cinfo.scale_denom = util::scaleDenominator({ cinfo.image_width, cinfo.image_height }, targetSize);
+
     jpeg_start_decompress(&cinfo);
 
     if (cinfo.out_color_space == JCS_UNKNOWN)
@@ -119,7 +126,7 @@ PremultipliedImage decodeJPEG(const uint8_t* data, size_t size) {
     size_t components = cinfo.output_components;
     size_t rowStride = components * width;
 
-    PremultipliedImage image({ static_cast<uint32_t>(width), static_cast<uint32_t>(height) });
+    Image<Mode> image({ static_cast<uint32_t>(width), static_cast<uint32_t>(height) });
     uint8_t* dst = image.data.get();
 
     JSAMPARRAY buffer = (*cinfo.mem->alloc_sarray)((j_common_ptr) &cinfo, JPOOL_IMAGE, rowStride, 1);
@@ -148,4 +155,7 @@ PremultipliedImage decodeJPEG(const uint8_t* data, size_t size) {
     return image;
 }
 
+template PremultipliedImage decodeJPEG<ImageAlphaMode::Premultiplied>(const uint8_t*, size_t, Size);
+template UnassociatedImage decodeJPEG<ImageAlphaMode::Unassociated>(const uint8_t*, size_t, Size);
+
 } // namespace mbgl
@@ -96,6 +96,9 @@ std::string encodeOfflineRegionDefinition(const OfflineRegionDefinition& region)
     return buffer.GetString();
 }
 
+constexpr uint8_t OfflineCodec::Uncompressed;
+constexpr uint8_t OfflineCodec::Zlib;
+
 OfflineRegion::OfflineRegion(int64_t id_,
                              OfflineRegionDefinition definition_,
                              OfflineRegionMetadata metadata_)
@@ -10,6 +10,21 @@
 
 namespace mbgl {
 
+namespace {
+
+class ZlibCodec : public OfflineCodec {
+public:
+    std::string compress(const std::string& data) override {
+        return util::compress(data);
+    }
+
+    std::string decompress(const std::string& data) override {
+        return util::decompress(data);
+    }
+};
+
+} // namespace
+
 OfflineDatabase::Statement::~Statement() {
     stmt.reset();
     stmt.clearBindings();
@@ -18,13 +33,26 @@ OfflineDatabase::Statement::~Statement() {
 OfflineDatabase::OfflineDatabase(std::string path_, uint64_t maximumCacheSize_)
     : path(std::move(path_)),
       maximumCacheSize(maximumCacheSize_) {
+    codecs.emplace(OfflineCodec::Zlib, std::make_shared<ZlibCodec>());
     ensureSchema();
 }
 
+OfflineDatabase::OfflineDatabase(std::string path_, ReadOnly)
+    : path(std::move(path_)),
+      readOnly(true),
+      maximumCacheSize(0) {
+    codecs.emplace(OfflineCodec::Zlib, std::make_shared<ZlibCodec>());
+    connect(mapbox::sqlite::ReadOnly);
+}
+
 OfflineDatabase::~OfflineDatabase() {
     // Deleting these SQLite objects may result in exceptions, but we're in a destructor, so we
     // can't throw anything.
     try {
+        if (batch.transaction) {
+            batch.transaction->commit();
+            batch.transaction.reset();
+        }
         statements.clear();
         db.reset();
     } catch (mapbox::sqlite::Exception& ex) {
@@ -36,6 +64,10 @@ void OfflineDatabase::connect(int flags) {
     db = std::make_unique<mapbox::sqlite::Database>(path.c_str(), flags);
     db->setBusyTimeout(Milliseconds::max());
     db->exec("PRAGMA foreign_keys = ON");
+
+    // In WAL journal mode, this only syncs to disk when checkpointing. It is a setting of the
+    // connection rather than of the database.
+    db->exec("PRAGMA synchronous = NORMAL");
 }
 
 void OfflineDatabase::ensureSchema() {
@@ -49,7 +81,8 @@ void OfflineDatabase::ensureSchema() {
             case 2: migrateToVersion3(); // fall through
             case 3: // no-op and fall through
             case 4: migrateToVersion5(); // fall through
-            case 5: return;
+            case 5: migrateToVersion6(); // fall through
+            case 6: return;
             default: throw std::runtime_error("unknown schema version");
             }
 
@@ -80,10 +113,9 @@ void OfflineDatabase::ensureSchema() {
 
         // If you change the schema you must write a migration from the previous version.
         db->exec("PRAGMA auto_vacuum = INCREMENTAL");
-        db->exec("PRAGMA journal_mode = DELETE");
-        db->exec("PRAGMA synchronous = FULL");
+        db->exec("PRAGMA journal_mode = WAL");
         db->exec(schema);
-        db->exec("PRAGMA user_version = 5");
+        db->exec("PRAGMA user_version = 6");
     } catch (...) {
         Log::Error(Event::Database, "Unexpected error creating database schema: %s", util::toString(std::current_exception()).c_str());
         throw;
@@ -106,6 +138,14 @@ void OfflineDatabase::removeExisting() {
     } catch (util::IOException& ex) {
         Log::Error(Event::Database, ex.code, ex.what());
     }
+
+    // A write-ahead log left behind must not be applied to the new database.
+    for (const char* suffix : { "-wal", "-shm" }) {
+        try {
+            util::deleteFile(path + suffix);
+        } catch (util::IOException&) {
+        }
+    }
 }
 
 void OfflineDatabase::migrateToVersion3() {
@@ -126,6 +166,15 @@ void OfflineDatabase::migrateToVersion5() {
     db->exec("PRAGMA user_version = 5");
 }
 
+// Version 6 switches to WAL journal mode, so that a read-only connection can read from the
+// cache while downloads write to it.
+
+void OfflineDatabase::migrateToVersion6() {
+    db->exec("PRAGMA journal_mode = WAL");
+    db->exec("PRAGMA synchronous = NORMAL");
+    db->exec("PRAGMA user_version = 6");
+}
+
 OfflineDatabase::Statement OfflineDatabase::getStatement(const char * sql) {
     auto it = statements.find(sql);
 
@@ -160,7 +209,15 @@ optional<int64_t> OfflineDatabase::hasInternal(const Resource& resource) {
 }
 
 std::pair<bool, uint64_t> OfflineDatabase::put(const Resource& resource, const Response& response) {
-    return putInternal(resource, response, true);
+    joinBatch();
+    try {
+        auto result = putInternal(resource, response, true);
+        countBatchedWrite();
+        return result;
+    } catch (...) {
+        abortBatch();
+        throw;
+    }
 }
 
 std::pair<bool, uint64_t> OfflineDatabase::putInternal(const Resource& resource, const Response& response, bool evict_) {
@@ -172,8 +229,13 @@ std::pair<bool, uint64_t> OfflineDatabase::putInternal(const Resource& resource,
     bool compressed = false;
     uint64_t size = 0;
 
-    if (response.data) {
-        compressedData = util::compress(*response.data);
+    auto it = kindCodecs.find(resource.kind);
+    const uint8_t codec = it != kindCodecs.end() ? it->second : OfflineCodec::Zlib;
+
+    if (response.data && codec == OfflineCodec::Uncompressed) {
+        size = response.data->size();
+    } else if (response.data) {
+        compressedData = codecs.at(codec)->compress(*response.data);
         compressed = compressedData.size() < response.data->size();
         size = compressed ? compressedData.size() : response.data->size();
     }
@@ -189,17 +251,56 @@ std::pair<bool, uint64_t> OfflineDatabase::putInternal(const Resource& resource,
         assert(resource.tileData);
         inserted = putTile(*resource.tileData, response,
                 compressed ? compressedData : *response.data,
-                compressed);
+                compressed ? codec : OfflineCodec::Uncompressed);
     } else {
         inserted = putResource(resource, response,
                 compressed ? compressedData : *response.data,
-                compressed);
+                compressed ? codec : OfflineCodec::Uncompressed);
     }
 
     return { inserted, size };
 }
 
-optional<std::pair<Response, uint64_t>> OfflineDatabase::getResource(const Resource& resource) {
+bool OfflineDatabase::readData(Response& response, optional<std::string>&& data, uint8_t codec) {
+    if (!data) {
+        response.noContent = true;
+    } else if (codec == OfflineCodec::Uncompressed) {
+        response.data = std::make_shared<std::string>(std::move(*data));
+    } else {
+        auto it = codecs.find(codec);
+        if (it == codecs.end()) {
+            Log::Warning(Event::Database, "Unknown codec %d for stored resource", int(codec));
+            return false;
+        }
+        response.data = std::make_shared<std::string>(it->second->decompress(*data));
+    }
+
+    return true;
+}
+
+void OfflineDatabase::addCodec(uint8_t id, std::shared_ptr<OfflineCodec> codec) {
+    assert(id > OfflineCodec::Zlib);
+    assert(codec);
+    codecs[id] = std::move(codec);
+}
+
+void OfflineDatabase::useCodec(Resource::Kind kind, uint8_t id) {
+    if (id != OfflineCodec::Uncompressed && !codecs.count(id)) {
+        throw std::runtime_error("unknown codec");
+    }
+    kindCodecs[kind] = id;
+}
+
+void OfflineDatabase::markAccessed(const Resource& resource) {
+    if (resource.kind == Resource::Kind::Tile) {
+        assert(resource.tileData);
+        markTileAccessed(*resource.tileData);
+    } else {
+        markResourceAccessed(resource);
+    }
+}
+
+void OfflineDatabase::markResourceAccessed(const Resource& resource) {
     // clang-format off
     Statement accessedStmt = getStatement(
         "UPDATE resources SET accessed = ?1 WHERE url = ?2");
@@ -208,6 +309,12 @@ optional<std::pair<Response, uint64_t>> OfflineDatabase::getResource(const Resou
     accessedStmt->bind(1, util::now());
     accessedStmt->bind(2, resource.url);
     accessedStmt->run();
+}
+
+optional<std::pair<Response, uint64_t>> OfflineDatabase::getResource(const Resource& resource) {
+    if (!readOnly) {
+        markResourceAccessed(resource);
+    }
 
     // clang-format off
     Statement stmt = getStatement(
@@ -231,16 +338,14 @@ optional<std::pair<Response, uint64_t>> OfflineDatabase::getResource(const Resou
     response.modified = stmt->get<optional<Timestamp>>(2);
 
     optional<std::string> data = stmt->get<optional<std::string>>(3);
-    if (!data) {
-        response.noContent = true;
-    } else if (stmt->get<int>(4)) {
-        response.data = std::make_shared<std::string>(util::decompress(*data));
-        size = data->length();
-    } else {
-        response.data = std::make_shared<std::string>(*data);
+    if (data) {
         size = data->length();
     }
 
+    if (!readData(response, std::move(data), stmt->get<int>(4))) {
+        return {};
+    }
+
     return std::make_pair(response, size);
 }
 
@@ -260,7 +365,7 @@ optional<int64_t> OfflineDatabase::hasResource(const Resource& resource) {
 bool OfflineDatabase::putResource(const Resource& resource,
                                   const Response& response,
                                   const std::string& data,
-                                  bool compressed) {
+                                  uint8_t codec) {
     if (response.notModified) {
         // clang-format off
         Statement update = getStatement(
@@ -281,7 +386,7 @@ bool OfflineDatabase::putResource(const Resource& resource,
 
     // Begin an immediate-mode transaction to ensure that two writers do not attempt
     // to INSERT a resource at the same moment.
-    mapbox::sqlite::Transaction transaction(*db, mapbox::sqlite::Transaction::Immediate);
+    auto transaction = beginTransaction();
 
     // clang-format off
     Statement update = getStatement(
@@ -308,12 +413,14 @@ bool OfflineDatabase::putResource(const Resource& resource,
         update->bind(7, false);
     } else {
         update->bindBlob(6, data.data(), data.size(), false);
-        update->bind(7, compressed);
+        update->bind(7, codec);
     }
 
     update->run();
     if (update->changes() != 0) {
-        transaction.commit();
+        if (transaction) {
+            transaction->commit();
+        }
         return false;
     }
 
@@ -335,16 +442,18 @@ bool OfflineDatabase::putResource(const Resource& resource,
         insert->bind(8, false);
     } else {
         insert->bindBlob(7, data.data(), data.size(), false);
-        insert->bind(8, compressed);
+        insert->bind(8, codec);
     }
 
     insert->run();
-    transaction.commit();
+    if (transaction) {
+        transaction->commit();
+    }
 
     return true;
 }
 
-optional<std::pair<Response, uint64_t>> OfflineDatabase::getTile(const Resource::TileData& tile) {
+void OfflineDatabase::markTileAccessed(const Resource::TileData& tile) {
     // clang-format off
     Statement accessedStmt = getStatement(
         "UPDATE tiles "
@@ -363,6 +472,12 @@ optional<std::pair<Response, uint64_t>> OfflineDatabase::getTile(const Resource:
     accessedStmt->bind(5, tile.y);
     accessedStmt->bind(6, tile.z);
     accessedStmt->run();
+}
+
+optional<std::pair<Response, uint64_t>> OfflineDatabase::getTile(const Resource::TileData& tile) {
+    if (!readOnly) {
+        markTileAccessed(tile);
+    }
 
     // clang-format off
     Statement stmt = getStatement(
@@ -394,16 +509,14 @@ optional<std::pair<Response, uint64_t>> OfflineDatabase::getTile(const Resource:
     response.modified = stmt->get<optional<Timestamp>>(2);
 
     optional<std::string> data = stmt->get<optional<std::string>>(3);
-    if (!data) {
-        response.noContent = true;
-    } else if (stmt->get<int>(4)) {
-        response.data = std::make_shared<std::string>(util::decompress(*data));
-        size = data->length();
-    } else {
-        response.data = std::make_shared<std::string>(*data);
+    if (data) {
         size = data->length();
     }
 
+    if (!readData(response, std::move(data), stmt->get<int>(4))) {
+        return {};
+    }
+
     return std::make_pair(response, size);
 }
 
@@ -435,7 +548,7 @@ optional<int64_t> OfflineDatabase::hasTile(const Resource::TileData& tile) {
 bool OfflineDatabase::putTile(const Resource::TileData& tile,
                               const Response& response,
                               const std::string& data,
-                              bool compressed) {
+                              uint8_t codec) {
     if (response.notModified) {
         // clang-format off
         Statement update = getStatement(
@@ -464,7 +577,7 @@ bool OfflineDatabase::putTile(const Resource::TileData& tile,
 
     // Begin an immediate-mode transaction to ensure that two writers do not attempt
     // to INSERT a resource at the same moment.
-    mapbox::sqlite::Transaction transaction(*db, mapbox::sqlite::Transaction::Immediate);
+    auto transaction = beginTransaction();
 
     // clang-format off
     Statement update = getStatement(
@@ -497,12 +610,14 @@ bool OfflineDatabase::putTile(const Resource::TileData& tile,
         update->bind(6, false);
     } else {
         update->bindBlob(5, data.data(), data.size(), false);
-        update->bind(6, compressed);
+        update->bind(6, codec);
     }
 
     update->run();
     if (update->changes() != 0) {
-        transaction.commit();
+        if (transaction) {
+            transaction->commit();
+        }
         return false;
     }
 
@@ -527,11 +642,13 @@ bool OfflineDatabase::putTile(const Resource::TileData& tile,
         insert->bind(11, false);
     } else {
         insert->bindBlob(10, data.data(), data.size(), false);
-        insert->bind(11, compressed);
+        insert->bind(11, codec);
     }
 
     insert->run();
-    transaction.commit();
+    if (transaction) {
+        transaction->commit();
+    }
 
     return true;
 }
@@ -583,6 +700,9 @@ OfflineRegionMetadata OfflineDatabase::updateMetadata(const int64_t regionID, co
 }
 
 void OfflineDatabase::deleteRegion(OfflineRegion&& region) {
+    // Vacuuming below is done outside of a batch transaction.
+    commitBatch();
+
     // clang-format off
     Statement stmt = getStatement(
         "DELETE FROM regions WHERE id = ?");
@@ -619,17 +739,104 @@ optional<int64_t> OfflineDatabase::hasRegionResource(int64_t regionID, const Res
 }
 
 uint64_t OfflineDatabase::putRegionResource(int64_t regionID, const Resource& resource, const Response& response) {
-    uint64_t size = putInternal(resource, response, false).second;
-    bool previouslyUnused = markUsed(regionID, resource);
+    joinBatch();
+
+    try {
+        uint64_t size = putInternal(resource, response, false).second;
+        bool previouslyUnused = markUsed(regionID, resource);
+
+        if (offlineMapboxTileCount
+            && resource.kind == Resource::Kind::Tile
+            && util::mapbox::isMapboxURL(resource.url)
+            && previouslyUnused) {
+            *offlineMapboxTileCount += 1;
+        }
+
+        countBatchedWrite();
+
+        return size;
+    } catch (...) {
+        abortBatch();
+        throw;
+    }
+}
 
-    if (offlineMapboxTileCount
-        && resource.kind == Resource::Kind::Tile
-        && util::mapbox::isMapboxURL(resource.url)
-        && previouslyUnused) {
-        *offlineMapboxTileCount += 1;
+void OfflineDatabase::beginBatch(std::size_t maximumCount, Duration maximumDuration) {
+    if (batch.depth++ == 0) {
+        batch.maximumCount = maximumCount;
+        batch.maximumDuration = maximumDuration;
     }
+}
 
-    return size;
+void OfflineDatabase::commitBatch() {
+    if (!batch.transaction) {
+        return;
+    }
+
+    auto transaction = std::move(batch.transaction);
+    try {
+        transaction->commit();
+    } catch (const mapbox::sqlite::Exception&) {
+        // The batched writes are lost, and the tiles they counted with them.
+        offlineMapboxTileCount = {};
+
+        // SQLite rolls the whole transaction back by itself after some errors, such as a full
+        // disk, in which case there is nothing left to roll back.
+        try {
+            db->exec("ROLLBACK TRANSACTION");
+        } catch (const mapbox::sqlite::Exception&) {
+        }
+        throw;
+    }
+}
+
+void OfflineDatabase::abortBatch() {
+    if (!batch.transaction) {
+        return;
+    }
+
+    offlineMapboxTileCount = {};
+
+    auto transaction = std::move(batch.transaction);
+    try {
+        transaction->rollback();
+    } catch (const mapbox::sqlite::Exception&) {
+        // SQLite already rolled the transaction back.
+    }
+}
+
+void OfflineDatabase::endBatch() {
+    assert(batch.depth > 0);
+    if (--batch.depth == 0) {
+        commitBatch();
+    }
+}
+
+std::unique_ptr<mapbox::sqlite::Transaction> OfflineDatabase::beginTransaction() {
+    if (batch.transaction) {
+        return nullptr;
+    }
+    return std::make_unique<mapbox::sqlite::Transaction>(*db, mapbox::sqlite::Transaction::Immediate);
+}
+
+void OfflineDatabase::joinBatch() {
+    if (batch.depth == 0 || batch.transaction) {
+        return;
+    }
+
+    batch.transaction = std::make_unique<mapbox::sqlite::Transaction>(*db, mapbox::sqlite::Transaction::Immediate);
+    batch.count = 0;
+    batch.start = Clock::now();
+}
+
+void OfflineDatabase::countBatchedWrite() {
+    if (!batch.transaction) {
+        return;
+    }
+
+    if (++batch.count >= batch.maximumCount || Clock::now() - batch.start >= batch.maximumDuration) {
+        commitBatch();
+    }
 }
 
 bool OfflineDatabase::markUsed(int64_t regionID, const Resource& resource) {
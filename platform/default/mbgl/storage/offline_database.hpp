@@ -7,6 +7,7 @@
 #include <mbgl/util/constants.hpp>
 #include <mbgl/util/mapbox.hpp>
 
+#include <map>
 #include <unordered_map>
 #include <memory>
 #include <string>
@@ -15,6 +16,7 @@ namespace mapbox {
 namespace sqlite {
 class Database;
 class Statement;
+class Transaction;
 } // namespace sqlite
 } // namespace mapbox
 
@@ -28,10 +30,21 @@ public:
     // Limits affect ambient caching (put) only; resources required by offline
     // regions are exempt.
     OfflineDatabase(std::string path, uint64_t maximumCacheSize = util::DEFAULT_MAX_CACHE_SIZE);
+
+    // Opens a read-only connection to a database that a writable OfflineDatabase has created,
+    // for reading while the other connection writes. It sees the writes committed so far. Its
+    // get() leaves access times as they are; report what it finds with markAccessed() on the
+    // writable database instead.
+    struct ReadOnly {};
+    OfflineDatabase(std::string path, ReadOnly);
+
     ~OfflineDatabase();
 
     optional<Response> get(const Resource&);
 
+    // Records that the resource was just used, as get() does, so that it is evicted last.
+    void markAccessed(const Resource&);
+
     // Return value is (inserted, stored size)
     std::pair<bool, uint64_t> put(const Resource&, const Response&);
 
@@ -49,6 +62,27 @@ public:
     optional<int64_t> hasRegionResource(int64_t regionID, const Resource&);
     uint64_t putRegionResource(int64_t regionID, const Resource&, const Response&);
 
+    // Groups the writes made until the matching endBatch() into shared transactions rather
+    // than one transaction each. Pending writes are committed every `maximumCount` writes,
+    // once their transaction is `maximumDuration` old, and on commitBatch() or endBatch().
+    // Batches may be nested, in which case the limits of the outermost one apply. If a write
+    // or a commit fails, the pending writes of the batch are lost along with it, and the
+    // exception is rethrown.
+    void beginBatch(std::size_t maximumCount = util::DEFAULT_OFFLINE_BATCH_SIZE,
+                    Duration maximumDuration = util::DEFAULT_OFFLINE_BATCH_DURATION);
+    void commitBatch();
+    void endBatch();
+
+    // Registers a codec under an identifier above OfflineCodec::Zlib, to read the data it
+    // compressed. Register it with every database that opens the same file, such as a
+    // ReadOnly one. Resources stored with a codec this database doesn't know are treated
+    // as missing.
+    void addCodec(uint8_t id, std::shared_ptr<OfflineCodec>);
+
+    // Compresses the resources of this kind stored from now on with a registered codec, or
+    // stores them as is with OfflineCodec::Uncompressed.
+    void useCodec(Resource::Kind, uint8_t id);
+
     OfflineRegionDefinition getRegionDefinition(int64_t regionID);
     OfflineRegionStatus getRegionCompletedStatus(int64_t regionID);
 
@@ -64,6 +98,7 @@ private:
     void removeExisting();
     void migrateToVersion3();
     void migrateToVersion5();
+    void migrateToVersion6();
 
     class Statement {
     public:
@@ -80,15 +115,31 @@ private:
 
     Statement getStatement(const char *);
 
+    // Begins an immediate-mode transaction for a single write, unless the write is part of
+    // an open batch transaction, in which case nullptr is returned.
+    std::unique_ptr<mapbox::sqlite::Transaction> beginTransaction();
+
+    // Opens the batch transaction, if a batch is in progress, and counts a write against its
+    // limits once the write is done. A write that fails rolls back the batch transaction,
+    // which SQLite may already have done, and the next write opens a new one.
+    void joinBatch();
+    void countBatchedWrite();
+    void abortBatch();
+
+    void markTileAccessed(const Resource::TileData&);
     optional<std::pair<Response, uint64_t>> getTile(const Resource::TileData&);
     optional<int64_t> hasTile(const Resource::TileData&);
     bool putTile(const Resource::TileData&, const Response&,
-                 const std::string&, bool compressed);
+                 const std::string&, uint8_t codec);
 
+    void markResourceAccessed(const Resource&);
     optional<std::pair<Response, uint64_t>> getResource(const Resource&);
     optional<int64_t> hasResource(const Resource&);
     bool putResource(const Resource&, const Response&,
-                     const std::string&, bool compressed);
+                     const std::string&, uint8_t codec);
+
+    // Fills the data of the response from a stored row, returning false if its codec is unknown.
+    bool readData(Response&, optional<std::string>&& data, uint8_t codec);
 
     optional<std::pair<Response, uint64_t>> getInternal(const Resource&);
     optional<int64_t> hasInternal(const Resource&);
@@ -101,6 +152,7 @@ private:
     std::pair<int64_t, int64_t> getCompletedTileCountAndSize(int64_t regionID);
 
     const std::string path;
+    const bool readOnly = false;
     std::unique_ptr<::mapbox::sqlite::Database> db;
     std::unordered_map<const char *, std::unique_ptr<::mapbox::sqlite::Statement>> statements;
 
@@ -113,6 +165,19 @@ private:
     optional<uint64_t> offlineMapboxTileCount;
 
     bool evict(uint64_t neededFreeSize);
+
+    std::unordered_map<uint8_t, std::shared_ptr<OfflineCodec>> codecs;
+    std::map<Resource::Kind, uint8_t> kindCodecs;
+
+    struct Batch {
+        std::size_t depth = 0;
+        std::size_t maximumCount = 0;
+        Duration maximumDuration = Duration::zero();
+
+        std::unique_ptr<mapbox::sqlite::Transaction> transaction;
+        std::size_t count = 0;
+        TimePoint start;
+    } batch;
 };
 
 } // namespace mbgl
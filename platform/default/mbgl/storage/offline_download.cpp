@@ -8,6 +8,8 @@
 #include <mbgl/style/sources/geojson_source_impl.hpp>
 #include <mbgl/style/tile_source_impl.hpp>
 #include <mbgl/text/glyph.hpp>
+#include <mbgl/util/constants.hpp>
+#include <mbgl/util/logging.hpp>
 #include <mbgl/util/mapbox.hpp>
 #include <mbgl/util/run_loop.hpp>
 #include <mbgl/util/tile_cover.hpp>
@@ -28,7 +30,11 @@ OfflineDownload::OfflineDownload(int64_t id_,
     setObserver(nullptr);
 }
 
-OfflineDownload::~OfflineDownload() = default;
+OfflineDownload::~OfflineDownload() {
+    if (status.downloadState == OfflineRegionDownloadState::Active) {
+        deactivateDownload();
+    }
+}
 
 void OfflineDownload::setObserver(std::unique_ptr<OfflineRegionObserver> observer_) {
     observer = observer_ ? std::move(observer_) : std::make_unique<OfflineRegionObserver>();
@@ -128,6 +134,24 @@ void OfflineDownload::activateDownload() {
     status = OfflineRegionStatus();
     status.downloadState = OfflineRegionDownloadState::Active;
     status.requiredResourceCount++;
+
+    // Store the downloaded resources in batches rather than with a transaction each.
+    offlineDatabase.beginBatch();
+    batchTimer.start(util::DEFAULT_OFFLINE_BATCH_DURATION, util::DEFAULT_OFFLINE_BATCH_DURATION, [this] {
+        try {
+            offlineDatabase.commitBatch();
+        } catch (const std::exception& ex) {
+            // Stopping the download stops this timer, which can't be done from its callback.
+            const std::string message = ex.what();
+            auto requestsIt = requests.insert(requests.begin(), nullptr);
+            *requestsIt = util::RunLoop::Get()->invokeCancellable([this, requestsIt, message] {
+                requests.erase(requestsIt);
+                storageFailed(message);
+                setState(OfflineRegionDownloadState::Inactive);
+            });
+        }
+    });
+
     ensureResource(Resource::style(definition.styleURL), [&](Response styleResponse) {
         status.requiredResourceCountIsPrecise = true;
 
@@ -232,6 +256,26 @@ void OfflineDownload::deactivateDownload() {
     requiredSourceURLs.clear();
     resourcesRemaining.clear();
     requests.clear();
+
+    batchTimer.stop();
+    try {
+        offlineDatabase.endBatch();
+    } catch (const std::exception& ex) {
+        storageFailed(ex.what());
+    }
+}
+
+void OfflineDownload::storageFailed(const std::string& message) {
+    Log::Error(Event::Database, "Failed to store offline resources: %s", message.c_str());
+
+    // The resources of the failed batch were counted as completed but are no longer stored.
+    const OfflineRegionStatus stored = offlineDatabase.getRegionCompletedStatus(id);
+    status.completedResourceCount = stored.completedResourceCount;
+    status.completedResourceSize = stored.completedResourceSize;
+    status.completedTileCount = stored.completedTileCount;
+    status.completedTileSize = stored.completedTileSize;
+
+    observer->responseError(Response::Error(Response::Error::Reason::Other, message));
 }
 
 void OfflineDownload::queueResource(Resource resource) {
@@ -296,8 +340,16 @@ void OfflineDownload::ensureResource(const Resource& resource,
                 callback(onlineResponse);
             }
 
+            uint64_t resourceSize = 0;
+            try {
+                resourceSize = offlineDatabase.putRegionResource(id, resource, onlineResponse);
+            } catch (const std::exception& ex) {
+                storageFailed(ex.what());
+                setState(OfflineRegionDownloadState::Inactive);
+                return;
+            }
+
             status.completedResourceCount++;
-            uint64_t resourceSize = offlineDatabase.putRegionResource(id, resource, onlineResponse);
             status.completedResourceSize += resourceSize;
             if (resource.kind == Resource::Kind::Tile) {
                 status.completedTileCount += 1;
@@ -2,6 +2,7 @@
 
 #include <mbgl/storage/offline.hpp>
 #include <mbgl/storage/resource.hpp>
+#include <mbgl/util/timer.hpp>
 
 #include <list>
 #include <unordered_set>
@@ -48,6 +49,12 @@ private:
     void ensureResource(const Resource&, std::function<void (Response)> = {});
     bool checkTileCountLimit(const Resource& resource);
 
+    /*
+     * Reports that resources could not be stored, and recounts the completed resources from
+     * the database, since the failure may have lost resources that were already counted.
+     */
+    void storageFailed(const std::string& message);
+
     int64_t id;
     OfflineRegionDefinition definition;
     OfflineDatabase& offlineDatabase;
@@ -59,6 +66,10 @@ private:
     std::unordered_set<std::string> requiredSourceURLs;
     std::deque<Resource> resourcesRemaining;
 
+    // Commits the writes batched while the download is active, so that they do not wait for
+    // the batch to fill up when responses arrive slowly.
+    util::Timer batchTimer;
+
     void queueResource(Resource);
     void queueTiles(SourceType, uint16_t tileSize, const Tileset&);
 };
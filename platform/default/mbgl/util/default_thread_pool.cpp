@@ -3,9 +3,12 @@
 #include <mbgl/util/platform.hpp>
 #include <mbgl/util/string.hpp>
 
+#include <algorithm>
+
 namespace mbgl {
 
-ThreadPool::ThreadPool(std::size_t count) {
+ThreadPool::ThreadPool(std::size_t count, ReceiveQuantum quantum_)
+    : quantum(std::move(quantum_)) {
     threads.reserve(count);
     for (std::size_t i = 0; i < count; ++i) {
         threads.emplace_back([this, i]() {
@@ -14,19 +17,23 @@ ThreadPool::ThreadPool(std::size_t count) {
             while (true) {
                 std::unique_lock<std::mutex> lock(mutex);
 
-                cv.wait(lock, [this] {
-                    return !queue.empty() || terminate;
+                auto it = queues.end();
+                cv.wait(lock, [&] {
+                    it = std::find_if(queues.begin(), queues.end(), [] (const auto& queue) {
+                        return !queue.empty();
+                    });
+                    return it != queues.end() || terminate;
                 });
 
                 if (terminate) {
                     return;
                 }
 
-                auto mailbox = queue.front();
-                queue.pop();
+                auto mailbox = it->front();
+                it->pop();
                 lock.unlock();
 
-                Mailbox::maybeReceive(mailbox);
+                Mailbox::maybeReceive(mailbox, quantum);
             }
         });
     }
@@ -46,12 +53,26 @@ ThreadPool::~ThreadPool() {
 }
 
 void ThreadPool::schedule(std::weak_ptr<Mailbox> mailbox) {
+    scheduleWithPriority(std::move(mailbox), Priority::Normal);
+}
+
+void ThreadPool::scheduleWithPriority(std::weak_ptr<Mailbox> mailbox, Priority priority) {
     {
         std::lock_guard<std::mutex> lock(mutex);
-        queue.push(mailbox);
+        queues[static_cast<std::size_t>(Priority::High) - static_cast<std::size_t>(priority)].push(std::move(mailbox));
     }
 
     cv.notify_one();
 }
 
+void ThreadPool::enableInstrumentation() {
+    if (!instrumentation) {
+        instrumentation = std::make_unique<actor::Instrumentation>();
+    }
+}
+
+actor::Instrumentation* ThreadPool::getInstrumentation() {
+    return instrumentation.get();
+}
+
 } // namespace mbgl
@@ -1,7 +1,9 @@
 #pragma once
 
 #include <mbgl/actor/scheduler.hpp>
+#include <mbgl/actor/mailbox.hpp>
 
+#include <array>
 #include <condition_variable>
 #include <mutex>
 #include <queue>
@@ -11,14 +13,26 @@ namespace mbgl {
 
 class ThreadPool : public Scheduler {
 public:
-    ThreadPool(std::size_t count);
+    // By default, a thread receives one message from a mailbox before moving on to the next
+    // mailbox. Use a larger `quantum` to drain several messages at once.
+    ThreadPool(std::size_t count, ReceiveQuantum quantum = {});
     ~ThreadPool() override;
 
     void schedule(std::weak_ptr<Mailbox>) override;
+    void scheduleWithPriority(std::weak_ptr<Mailbox>, Priority) override;
+
+    // Starts collecting statistics for actors that are created from now on. Use
+    // `getInstrumentation()->snapshot()` to read them.
+    void enableInstrumentation();
+    actor::Instrumentation* getInstrumentation() override;
 
 private:
+    const ReceiveQuantum quantum;
+    std::unique_ptr<actor::Instrumentation> instrumentation;
     std::vector<std::thread> threads;
-    std::queue<std::weak_ptr<Mailbox>> queue;
+
+    // One queue per priority, ordered from highest to lowest priority.
+    std::array<std::queue<std::weak_ptr<Mailbox>>, 3> queues;
     std::mutex mutex;
     std::condition_variable cv;
     bool terminate { false };
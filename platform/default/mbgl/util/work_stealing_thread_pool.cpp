@@ -0,0 +1,271 @@
+#include <mbgl/util/work_stealing_thread_pool.hpp>
+#include <mbgl/actor/mailbox.hpp>
+#include <mbgl/util/platform.hpp>
+#include <mbgl/util/string.hpp>
+#include <mbgl/util/thread_local.hpp>
+
+#include <cassert>
+#include <deque>
+#include <queue>
+
+namespace mbgl {
+
+// Bounded multi-producer/multi-consumer queue after Dmitry Vyukov. Producers and consumers
+// only synchronize through the per-cell sequence numbers, so no lock is taken unless the
+// queue is full, in which case mailboxes wait in a locked overflow queue instead.
+class WorkStealingThreadPool::InjectionQueue {
+public:
+    InjectionQueue(std::size_t capacity)
+        : cells(capacity),
+          mask(capacity - 1) {
+        assert((capacity & mask) == 0);
+        for (std::size_t i = 0; i < capacity; ++i) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    void push(std::weak_ptr<Mailbox> mailbox) {
+        if (!tryPush(mailbox)) {
+            std::lock_guard<std::mutex> lock(overflowMutex);
+            overflow.push(std::move(mailbox));
+            overflowSize++;
+        }
+    }
+
+    bool pop(std::weak_ptr<Mailbox>& mailbox) {
+        if (tryPop(mailbox)) {
+            return true;
+        }
+
+        if (overflowSize == 0) {
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(overflowMutex);
+        if (overflow.empty()) {
+            return false;
+        }
+        mailbox = std::move(overflow.front());
+        overflow.pop();
+        overflowSize--;
+        return true;
+    }
+
+private:
+    // Returns false if the queue is full, in which case `mailbox` is left untouched.
+    bool tryPush(std::weak_ptr<Mailbox>& mailbox) {
+        Cell* cell;
+        std::size_t pos = enqueuePos.load(std::memory_order_relaxed);
+        while (true) {
+            cell = &cells[pos & mask];
+            const std::size_t seq = cell->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+            if (diff == 0) {
+                if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->mailbox = std::move(mailbox);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool tryPop(std::weak_ptr<Mailbox>& mailbox) {
+        Cell* cell;
+        std::size_t pos = dequeuePos.load(std::memory_order_relaxed);
+        while (true) {
+            cell = &cells[pos & mask];
+            const std::size_t seq = cell->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1);
+            if (diff == 0) {
+                if (dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = dequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        mailbox = std::move(cell->mailbox);
+        cell->sequence.store(pos + mask + 1, std::memory_order_release);
+        return true;
+    }
+
+    struct Cell {
+        std::atomic<std::size_t> sequence;
+        std::weak_ptr<Mailbox> mailbox;
+    };
+
+    static constexpr std::size_t cacheLine = 64;
+
+    std::vector<Cell> cells;
+    const std::size_t mask;
+
+    // Keep the two cursors on separate cache lines to avoid false sharing between
+    // producers and consumers.
+    char padding0[cacheLine];
+    std::atomic<std::size_t> enqueuePos { 0 };
+    char padding1[cacheLine];
+    std::atomic<std::size_t> dequeuePos { 0 };
+
+    std::mutex overflowMutex;
+    std::queue<std::weak_ptr<Mailbox>> overflow;
+    std::atomic<std::size_t> overflowSize { 0 };
+};
+
+// The owning worker takes mailboxes from the front, in the order they were scheduled,
+// while thieves take them from the back. Both ends are only contended during a steal.
+class WorkStealingThreadPool::WorkerQueue {
+public:
+    void push(std::weak_ptr<Mailbox> mailbox) {
+        std::lock_guard<std::mutex> lock(mutex);
+        queue.push_back(std::move(mailbox));
+    }
+
+    bool pop(std::weak_ptr<Mailbox>& mailbox) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (queue.empty()) {
+            return false;
+        }
+        mailbox = std::move(queue.front());
+        queue.pop_front();
+        return true;
+    }
+
+    bool steal(std::weak_ptr<Mailbox>& mailbox) {
+        std::unique_lock<std::mutex> lock(mutex, std::try_to_lock);
+        if (!lock.owns_lock() || queue.empty()) {
+            return false;
+        }
+        mailbox = std::move(queue.back());
+        queue.pop_back();
+        return true;
+    }
+
+private:
+    std::mutex mutex;
+    std::deque<std::weak_ptr<Mailbox>> queue;
+};
+
+namespace {
+
+constexpr std::size_t injectionCapacity = 1024;
+
+} // namespace
+
+WorkStealingThreadPool::WorkStealingThreadPool(std::size_t count, ReceiveQuantum quantum_)
+    : quantum(std::move(quantum_)),
+      urgent(std::make_unique<InjectionQueue>(injectionCapacity)),
+      injection(std::make_unique<InjectionQueue>(injectionCapacity)),
+      background(std::make_unique<InjectionQueue>(injectionCapacity)),
+      currentWorker(std::make_unique<util::ThreadLocal<std::size_t>>()) {
+    workers.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        workers.push_back(std::make_unique<WorkerQueue>());
+    }
+
+    threads.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        threads.emplace_back([this, i]() {
+            platform::setCurrentThreadName(std::string{ "Worker " } + util::toString(i + 1));
+            currentWorker->set(new std::size_t(i));
+
+            std::weak_ptr<Mailbox> mailbox;
+            while (true) {
+                if (pop(i, mailbox)) {
+                    Mailbox::maybeReceive(std::move(mailbox), quantum);
+                    continue;
+                }
+
+                std::unique_lock<std::mutex> lock(mutex);
+
+                // `sleeping` is raised before `pending` is checked, and `schedule()` raises
+                // `pending` before checking `sleeping`, so a wakeup can't be lost.
+                sleeping++;
+                cv.wait(lock, [this] {
+                    return pending > 0 || terminate;
+                });
+                sleeping--;
+
+                if (terminate) {
+                    return;
+                }
+            }
+        });
+    }
+}
+
+WorkStealingThreadPool::~WorkStealingThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        terminate = true;
+    }
+
+    cv.notify_all();
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+void WorkStealingThreadPool::schedule(std::weak_ptr<Mailbox> mailbox) {
+    scheduleWithPriority(std::move(mailbox), Priority::Normal);
+}
+
+void WorkStealingThreadPool::scheduleWithPriority(std::weak_ptr<Mailbox> mailbox, Priority priority) {
+    std::size_t* index = priority == Priority::Normal ? currentWorker->get() : nullptr;
+    InjectionQueue& queue = priority == Priority::High ? *urgent
+                          : priority == Priority::Low ? *background
+                          : *injection;
+
+    if (index) {
+        workers[*index]->push(std::move(mailbox));
+    } else {
+        queue.push(std::move(mailbox));
+    }
+
+    pending++;
+
+    if (sleeping > 0) {
+        std::lock_guard<std::mutex> lock(mutex);
+        cv.notify_one();
+    }
+}
+
+bool WorkStealingThreadPool::pop(std::size_t index, std::weak_ptr<Mailbox>& mailbox) {
+    bool found = urgent->pop(mailbox) || workers[index]->pop(mailbox) || injection->pop(mailbox);
+
+    for (std::size_t i = 1; !found && i < workers.size(); ++i) {
+        found = workers[(index + i) % workers.size()]->steal(mailbox);
+    }
+
+    if (!found) {
+        found = background->pop(mailbox);
+    }
+
+    if (found) {
+        pending--;
+    }
+
+    return found;
+}
+
+void WorkStealingThreadPool::enableInstrumentation() {
+    if (!instrumentation) {
+        instrumentation = std::make_unique<actor::Instrumentation>();
+    }
+}
+
+actor::Instrumentation* WorkStealingThreadPool::getInstrumentation() {
+    return instrumentation.get();
+}
+
+} // namespace mbgl
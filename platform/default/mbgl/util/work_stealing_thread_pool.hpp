@@ -0,0 +1,75 @@
+#pragma once
+
+#include <mbgl/actor/scheduler.hpp>
+#include <mbgl/actor/mailbox.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mbgl {
+
+namespace util {
+template <class> class ThreadLocal;
+} // namespace util
+
+/*
+    A `WorkStealingThreadPool` is a drop-in alternative to `ThreadPool` for machines with
+    many cores, where the single queue of `ThreadPool` becomes a point of contention.
+
+    Each worker owns a deque. Mailboxes scheduled from a worker thread are pushed onto that
+    worker's own deque; mailboxes scheduled from any other thread go through a lock-free
+    injection queue. An idle worker drains its own deque first, then the injection queue,
+    and finally steals from the deques of the other workers.
+
+    High priority mailboxes are always pushed onto a separate injection queue that workers
+    check before anything else, and low priority mailboxes onto one that is only checked when
+    there is nothing left to steal. A full injection queue keeps further mailboxes in an
+    overflow of its own, which is drained along with it.
+
+    The guarantees of `Scheduler` are preserved: the `Mailbox` only reschedules itself once
+    it has processed its last message, so its messages are never processed concurrently.
+    Raising the priority of a waiting mailbox schedules it again in the queue of its new
+    priority; whichever entry is popped first receives, and the other one is ignored.
+*/
+
+class WorkStealingThreadPool : public Scheduler {
+public:
+    WorkStealingThreadPool(std::size_t count, ReceiveQuantum quantum = {});
+    ~WorkStealingThreadPool() override;
+
+    void schedule(std::weak_ptr<Mailbox>) override;
+    void scheduleWithPriority(std::weak_ptr<Mailbox>, Priority) override;
+
+    // Starts collecting statistics for actors that are created from now on. Use
+    // `getInstrumentation()->snapshot()` to read them.
+    void enableInstrumentation();
+    actor::Instrumentation* getInstrumentation() override;
+
+private:
+    class InjectionQueue;
+    class WorkerQueue;
+
+    bool pop(std::size_t index, std::weak_ptr<Mailbox>&);
+
+    const ReceiveQuantum quantum;
+    std::unique_ptr<actor::Instrumentation> instrumentation;
+
+    std::unique_ptr<InjectionQueue> urgent;
+    std::unique_ptr<InjectionQueue> injection;
+    std::unique_ptr<InjectionQueue> background;
+    std::vector<std::unique_ptr<WorkerQueue>> workers;
+    std::unique_ptr<util::ThreadLocal<std::size_t>> currentWorker;
+
+    std::atomic<std::size_t> pending { 0 };
+    std::atomic<std::size_t> sleeping { 0 };
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool terminate { false };
+
+    std::vector<std::thread> threads;
+};
+
+} // namespace mbgl
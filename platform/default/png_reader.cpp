@@ -62,7 +62,8 @@ struct png_struct_guard {
     png_infopp i_;
 };
 
-PremultipliedImage decodePNG(const uint8_t* data, size_t size) {
+template <ImageAlphaMode Mode>
+Image<Mode> decodePNG(const uint8_t* data, size_t size) {
     util::CharArrayBuffer dataBuffer { reinterpret_cast<const char*>(data), size };
     std::istream stream(&dataBuffer);
 
@@ -98,6 +99,9 @@ PremultipliedImage decodePNG(const uint8_t* data, size_t size) {
     int color_type = 0;
     png_get_IHDR(png_ptr, info_ptr, &width, &height, &bit_depth, &color_type, nullptr, nullptr, nullptr);
 
+    const bool opaque = !(color_type & PNG_COLOR_MASK_ALPHA) &&
+                        !png_get_valid(png_ptr, info_ptr, PNG_INFO_tRNS);
+
     UnassociatedImage image({ width, height });
 
     if (color_type == PNG_COLOR_TYPE_PALETTE)
@@ -136,7 +140,10 @@ PremultipliedImage decodePNG(const uint8_t* data, size_t size) {
 
     png_read_end(png_ptr, nullptr);
 
-    return util::premultiply(std::move(image));
+    return util::withAlphaMode<Mode>(std::move(image), opaque);
 }
 
+template PremultipliedImage decodePNG<ImageAlphaMode::Premultiplied>(const uint8_t*, size_t);
+template UnassociatedImage decodePNG<ImageAlphaMode::Unassociated>(const uint8_t*, size_t);
+
 } // namespace mbgl
@@ -1,5 +1,6 @@
 #include <mbgl/util/image.hpp>
 #include <mbgl/util/premultiply.hpp>
+#include <mbgl/util/image_scale.hpp>
 #include <mbgl/util/logging.hpp>
 
 extern "C"
@@ -9,23 +10,52 @@ extern "C"
 
 namespace mbgl {
 
-PremultipliedImage decodeWebP(const uint8_t* data, size_t size) {
-    int width = 0, height = 0;
-    if (WebPGetInfo(data, size, &width, &height) == 0) {
+// Images larger than `targetSize` are reduced while they are decoded, with WebP's scaled
+// output.
+template <ImageAlphaMode Mode>
+Image<Mode> decodeWebP(const uint8_t* data, size_t size, Size targetSize) {
+    WebPDecoderConfig config;
+    if (!WebPInitDecoderConfig(&config)) {
+        throw std::runtime_error("failed to initialize WebP decoder");
+    }
+
+    if (WebPGetFeatures(data, size, &config.input) != VP8_STATUS_OK) {
         throw std::runtime_error("failed to retrieve WebP basic header information");
     }
 
+    int width = config.input.width;
+    int height = config.input.height;
+
+    const uint32_t denominator = util::scaleDenominator(
+        { static_cast<uint32_t>(width), static_cast<uint32_t>(height) }, targetSize);
+    if (denominator > 1) {
+        width = (width + denominator - 1) / denominator;
+        height = (height + denominator - 1) / denominator;
+        config.options.use_scaling = 1;
+        config.options.scaled_width = width;
+        config.options.scaled_height = height;
+    }
+
     int stride = width * 4;
     size_t webpSize = stride * height;
     auto webp = std::make_unique<uint8_t[]>(webpSize);
 
-    if (!WebPDecodeRGBAInto(data, size, webp.get(), webpSize, stride)) {
+    config.output.colorspace = MODE_RGBA;
+    config.output.is_external_memory = 1;
+    config.output.u.RGBA.rgba = webp.get();
+    config.output.u.RGBA.stride = stride;
+    config.output.u.RGBA.size = webpSize;
+
+    if (WebPDecode(data, size, &config) != VP8_STATUS_OK) {
         throw std::runtime_error("failed to decode WebP data");
     }
 
     UnassociatedImage image({ static_cast<uint32_t>(width), static_cast<uint32_t>(height) },
                             std::move(webp));
-    return util::premultiply(std::move(image));
+    return util::withAlphaMode<Mode>(std::move(image), !config.input.has_alpha);
 }
 
+template PremultipliedImage decodeWebP<ImageAlphaMode::Premultiplied>(const uint8_t*, size_t, Size);
+template UnassociatedImage decodeWebP<ImageAlphaMode::Unassociated>(const uint8_t*, size_t, Size);
+
 } // namespace mbgl
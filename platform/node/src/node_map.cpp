@@ -12,6 +12,7 @@
 #include <mbgl/sprite/sprite_image.hpp>
 #include <mbgl/map/backend_scope.hpp>
 #include <mbgl/map/query.hpp>
+#include <mbgl/util/default_thread_pool.hpp>
 
 #include <unistd.h>
 
@@ -74,6 +75,7 @@ void NodeMap::Init(v8::Local<v8::Object> target) {
 
     Nan::SetPrototypeMethod(tpl, "dumpDebugLogs", DumpDebugLogs);
     Nan::SetPrototypeMethod(tpl, "queryRenderedFeatures", QueryRenderedFeatures);
+    Nan::SetPrototypeMethod(tpl, "getMemoryUsage", GetMemoryUsage);
 
     constructor.Reset(tpl->GetFunction());
     Nan::Set(target, Nan::New("Map").ToLocalChecked(), tpl->GetFunction());
@@ -113,6 +115,9 @@ void NodeMap::Init(v8::Local<v8::Object> target) {
  * over the internet
  * @param {Function} [options.cancel]
  * @param {number} options.ratio pixel ratio
+ * @param {number} [options.threads] number of threads in a dedicated thread pool for
+ * parsing and layout. By default, this work runs on the libuv thread pool, shared with
+ * other asynchronous I/O.
  * @example
  * var map = new mbgl.Map({ request: function() {} });
  * map.load(require('./test/fixtures/style.json'));
@@ -149,6 +154,13 @@ void NodeMap::New(const Nan::FunctionCallbackInfo<v8::Value>& info) {
         return Nan::ThrowError("Options object 'ratio' property must be a number");
     }
 
+    if (Nan::Has(options, Nan::New("threads").ToLocalChecked()).FromJust()) {
+        auto threads = Nan::Get(options, Nan::New("threads").ToLocalChecked()).ToLocalChecked();
+        if (!threads->IsUint32() || threads->Uint32Value() == 0) {
+            return Nan::ThrowError("Options object 'threads' property must be a positive integer");
+        }
+    }
+
     info.This()->SetInternalField(1, options);
 
     try {
@@ -506,6 +518,7 @@ void NodeMap::release() {
     });
 
     map.reset();
+    threadpool.reset();
 }
 
 void NodeMap::AddClass(const Nan::FunctionCallbackInfo<v8::Value>& info) {
@@ -957,6 +970,40 @@ void NodeMap::QueryRenderedFeatures(const Nan::FunctionCallbackInfo<v8::Value>&
     }
 }
 
+void NodeMap::GetMemoryUsage(const Nan::FunctionCallbackInfo<v8::Value>& info) {
+    auto nodeMap = Nan::ObjectWrap::Unwrap<NodeMap>(info.Holder());
+    if (!nodeMap->map) return Nan::ThrowError(releasedMessage());
+
+    const mbgl::MapMemoryUsage usage = nodeMap->map->getMemoryUsage();
+
+    auto toJS = [] (const mbgl::MemoryUsage& value) {
+        v8::Local<v8::Object> result = Nan::New<v8::Object>();
+        Nan::Set(result, Nan::New("cpu").ToLocalChecked(), Nan::New<v8::Number>(value.cpu));
+        Nan::Set(result, Nan::New("gpu").ToLocalChecked(), Nan::New<v8::Number>(value.gpu));
+        return result;
+    };
+
+    auto mapToJS = [&] (const std::unordered_map<std::string, mbgl::MemoryUsage>& values) {
+        v8::Local<v8::Object> result = Nan::New<v8::Object>();
+        for (const auto& pair : values) {
+            Nan::Set(result, Nan::New(pair.first).ToLocalChecked(), toJS(pair.second));
+        }
+        return result;
+    };
+
+    v8::Local<v8::Object> result = Nan::New<v8::Object>();
+    Nan::Set(result, Nan::New("sources").ToLocalChecked(), mapToJS(usage.sources));
+    Nan::Set(result, Nan::New("layers").ToLocalChecked(), mapToJS(usage.layers));
+    Nan::Set(result, Nan::New("glyphAtlas").ToLocalChecked(), toJS(usage.glyphAtlas));
+    Nan::Set(result, Nan::New("spriteAtlas").ToLocalChecked(), toJS(usage.spriteAtlas));
+    Nan::Set(result, Nan::New("lineAtlas").ToLocalChecked(), toJS(usage.lineAtlas));
+    Nan::Set(result, Nan::New("total").ToLocalChecked(), toJS(usage.total));
+    Nan::Set(result, Nan::New("bufferBytes").ToLocalChecked(), Nan::New<v8::Number>(usage.bufferBytes));
+    Nan::Set(result, Nan::New("textureBytes").ToLocalChecked(), Nan::New<v8::Number>(usage.textureBytes));
+
+    info.GetReturnValue().Set(result);
+}
+
 NodeMap::NodeMap(v8::Local<v8::Object> options)
     : pixelRatio([&] {
           Nan::HandleScope scope;
@@ -966,11 +1013,20 @@ NodeMap::NodeMap(v8::Local<v8::Object> options)
                            ->NumberValue()
                      : 1.0;
       }()),
+      threadpool([&]() -> std::unique_ptr<mbgl::Scheduler> {
+          Nan::HandleScope scope;
+          if (Nan::Has(options, Nan::New("threads").ToLocalChecked()).FromJust()) {
+              // Workers only post their results back to the main loop.
+              return std::make_unique<mbgl::ThreadPool>(
+                  Nan::Get(options, Nan::New("threads").ToLocalChecked()).ToLocalChecked()->Uint32Value());
+          }
+          return std::make_unique<NodeThreadPool>();
+      }()),
       map(std::make_unique<mbgl::Map>(backend,
                                       mbgl::Size{ 256, 256 },
                                       pixelRatio,
                                       *this,
-                                      threadpool,
+                                      *threadpool,
                                       mbgl::MapMode::Still)),
       async(new uv_async_t) {
 
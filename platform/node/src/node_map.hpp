@@ -56,6 +56,7 @@ public:
     static void SetPitch(const Nan::FunctionCallbackInfo<v8::Value>&);
     static void DumpDebugLogs(const Nan::FunctionCallbackInfo<v8::Value>&);
     static void QueryRenderedFeatures(const Nan::FunctionCallbackInfo<v8::Value>&);
+    static void GetMemoryUsage(const Nan::FunctionCallbackInfo<v8::Value>&);
 
     void startRender(RenderOptions options);
     void renderFinished();
@@ -69,7 +70,7 @@ public:
     const float pixelRatio;
     NodeBackend backend;
     std::unique_ptr<mbgl::OffscreenView> view;
-    NodeThreadPool threadpool;
+    std::unique_ptr<mbgl::Scheduler> threadpool;
     std::unique_ptr<mbgl::Map> map;
 
     std::exception_ptr error;
@@ -89,6 +89,35 @@ test('Map', function(t) {
         t.end();
     });
 
+    t.test('optional threads property must be a positive integer', function(t) {
+        var options = {
+            request: function() {}
+        };
+
+        options.threads = 'test';
+        t.throws(function() {
+            new mbgl.Map(options);
+        }, /Options object 'threads' property must be a positive integer/);
+
+        options.threads = 0;
+        t.throws(function() {
+            new mbgl.Map(options);
+        }, /Options object 'threads' property must be a positive integer/);
+
+        options.threads = 1.5;
+        t.throws(function() {
+            new mbgl.Map(options);
+        }, /Options object 'threads' property must be a positive integer/);
+
+        options.threads = 4;
+        t.doesNotThrow(function() {
+            var map = new mbgl.Map(options);
+            map.release();
+        });
+
+        t.end();
+    });
+
     t.test('instanceof mbgl.Map', function(t) {
         var options = {
             request: function() {},
@@ -121,7 +150,8 @@ test('Map', function(t) {
             'setBearing',
             'setPitch',
             'dumpDebugLogs',
-            'queryRenderedFeatures'
+            'queryRenderedFeatures',
+            'getMemoryUsage'
         ]);
 
         for (var key in keys) {
@@ -388,6 +418,51 @@ test('Map', function(t) {
         });
     });
 
+    t.test('.getMemoryUsage', function(t) {
+        var options = {
+            request: function() {},
+            ratio: 1
+        };
+
+        t.test('reports an empty map', function(t) {
+            var map = new mbgl.Map(options);
+            var usage = map.getMemoryUsage();
+
+            t.deepEqual(usage.sources, {});
+            t.deepEqual(usage.layers, {});
+            t.equal(usage.total.cpu, 0);
+            t.equal(usage.total.gpu, 0);
+
+            map.release();
+            t.end();
+        });
+
+        t.test('reports the sources and atlases of a style', function(t) {
+            var map = new mbgl.Map(options);
+            map.load(style);
+
+            var usage = map.getMemoryUsage();
+            t.deepEqual(usage.sources.mapbox, { cpu: 0, gpu: 0 });
+            t.ok(usage.glyphAtlas.cpu > 0);
+            t.ok(usage.lineAtlas.cpu > 0);
+            t.equal(usage.total.cpu, usage.glyphAtlas.cpu + usage.spriteAtlas.cpu + usage.lineAtlas.cpu);
+
+            map.release();
+            t.end();
+        });
+
+        t.test('requires a map that has not been released', function(t) {
+            var map = new mbgl.Map(options);
+            map.release();
+
+            t.throws(function() {
+                map.getMemoryUsage();
+            }, /Map resources have already been released/);
+
+            t.end();
+        });
+    });
+
     t.test('.render', function(t) {
         var options = {
             request: function(req, callback) {
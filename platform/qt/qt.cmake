@@ -35,6 +35,8 @@ set(MBGL_QT_FILES
     PRIVATE platform/default/mbgl/util/shared_thread_pool.hpp
     PRIVATE platform/default/mbgl/util/default_thread_pool.cpp
     PRIVATE platform/default/mbgl/util/default_thread_pool.hpp
+    PRIVATE platform/default/mbgl/util/work_stealing_thread_pool.cpp
+    PRIVATE platform/default/mbgl/util/work_stealing_thread_pool.hpp
 
     # Platform integration
     PRIVATE platform/qt/src/async_task.cpp
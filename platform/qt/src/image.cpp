@@ -20,11 +20,15 @@ std::string encodePNG(const PremultipliedImage& pre) {
 }
 
 #if !defined(QT_IMAGE_DECODERS)
-PremultipliedImage decodeJPEG(const uint8_t*, size_t);
-PremultipliedImage decodeWebP(const uint8_t*, size_t);
+template <ImageAlphaMode Mode>
+Image<Mode> decodeJPEG(const uint8_t*, size_t, Size targetSize);
+template <ImageAlphaMode Mode>
+Image<Mode> decodeWebP(const uint8_t*, size_t, Size targetSize);
 #endif
 
-PremultipliedImage decodeImage(const std::string& string) {
+// Images decoded by QImage are always decoded at full resolution.
+template <ImageAlphaMode Mode>
+static Image<Mode> decode(const std::string& string, QImage::Format format, Size targetSize) {
     const uint8_t* data = reinterpret_cast<const uint8_t*>(string.data());
     const size_t size = string.size();
 
@@ -33,22 +37,24 @@ PremultipliedImage decodeImage(const std::string& string) {
         uint32_t riff_magic = (data[0] << 24) | (data[1] << 16) | (data[2] << 8) | data[3];
         uint32_t webp_magic = (data[8] << 24) | (data[9] << 16) | (data[10] << 8) | data[11];
         if (riff_magic == 0x52494646 && webp_magic == 0x57454250) {
-            return decodeWebP(data, size);
+            return decodeWebP<Mode>(data, size, targetSize);
         }
     }
 
     if (size >= 2) {
         uint16_t magic = ((data[0] << 8) | data[1]) & 0xffff;
         if (magic == 0xFFD8) {
-            return decodeJPEG(data, size);
+            return decodeJPEG<Mode>(data, size, targetSize);
         }
     }
+#else
+    (void)targetSize;
 #endif
 
     QImage image =
         QImage::fromData(data, size)
         .rgbSwapped()
-        .convertToFormat(QImage::Format_ARGB32_Premultiplied);
+        .convertToFormat(format);
 
     if (image.isNull()) {
         throw std::runtime_error("Unsupported image type");
@@ -60,4 +66,13 @@ PremultipliedImage decodeImage(const std::string& string) {
     return { { static_cast<uint32_t>(image.width()), static_cast<uint32_t>(image.height()) },
              std::move(img) };
 }
+
+PremultipliedImage decodeImage(const std::string& string) {
+    return decode<ImageAlphaMode::Premultiplied>(string, QImage::Format_ARGB32_Premultiplied, {});
+}
+
+UnassociatedImage decodeUnassociatedImage(const std::string& string, Size targetSize) {
+    return decode<ImageAlphaMode::Unassociated>(string, QImage::Format_ARGB32, targetSize);
 }
+
+} // namespace mbgl
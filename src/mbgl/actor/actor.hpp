@@ -6,6 +6,7 @@
 #include <mbgl/util/noncopyable.hpp>
 
 #include <memory>
+#include <typeinfo>
 
 namespace mbgl {
 
@@ -48,7 +49,7 @@ class Actor : public util::noncopyable {
 public:
     template <class... Args>
     Actor(Scheduler& scheduler, Args&&... args_)
-        : mailbox(std::make_shared<Mailbox>(scheduler)),
+        : mailbox(std::make_shared<Mailbox>(scheduler, typeid(Object))),
           object(self(), std::forward<Args>(args_)...) {
     }
 
@@ -61,6 +62,10 @@ public:
         mailbox->push(actor::makeMessage(object, fn, std::forward<Args>(args)...));
     }
 
+    void setPriority(Scheduler::Priority priority) {
+        mailbox->setPriority(priority);
+    }
+
     ActorRef<std::decay_t<Object>> self() {
         return ActorRef<std::decay_t<Object>>(object, mailbox);
     }
@@ -0,0 +1,142 @@
+#include <mbgl/actor/instrumentation.hpp>
+
+#include <atomic>
+#include <cmath>
+
+#if defined(__GNUG__)
+#include <cxxabi.h>
+#include <cstdlib>
+#endif
+
+namespace mbgl {
+namespace actor {
+
+namespace {
+
+class AtomicHistogram {
+public:
+    void record(Duration duration) {
+        const auto us = std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+        std::size_t bucket = 0;
+        if (us > 0) {
+            bucket = std::min<std::size_t>(std::log2(us) + 1, Histogram::bucketCount - 1);
+        }
+
+        const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+        buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+        count.fetch_add(1, std::memory_order_relaxed);
+        total.fetch_add(ns, std::memory_order_relaxed);
+
+        auto current = max.load(std::memory_order_relaxed);
+        while (ns > current && !max.compare_exchange_weak(current, ns, std::memory_order_relaxed)) {
+        }
+    }
+
+    Histogram load() const {
+        Histogram result;
+        for (std::size_t i = 0; i < Histogram::bucketCount; ++i) {
+            result.buckets[i] = buckets[i].load(std::memory_order_relaxed);
+        }
+        result.count = count.load(std::memory_order_relaxed);
+        result.total = std::chrono::duration_cast<Duration>(std::chrono::nanoseconds(total.load(std::memory_order_relaxed)));
+        result.max = std::chrono::duration_cast<Duration>(std::chrono::nanoseconds(max.load(std::memory_order_relaxed)));
+        return result;
+    }
+
+private:
+    std::array<std::atomic<std::size_t>, Histogram::bucketCount> buckets {};
+    std::atomic<std::size_t> count { 0 };
+    std::atomic<int64_t> total { 0 };
+    std::atomic<int64_t> max { 0 };
+};
+
+std::string demangle(const char* name) {
+#if defined(__GNUG__)
+    int status = 0;
+    char* demangled = abi::__cxa_demangle(name, nullptr, nullptr, &status);
+    if (status == 0 && demangled) {
+        std::string result(demangled);
+        std::free(demangled);
+        return result;
+    }
+#endif
+    return name;
+}
+
+} // namespace
+
+class Instrumentation::Entry {
+public:
+    std::atomic<std::size_t> queueSamples { 0 };
+    std::atomic<std::size_t> queueTotal { 0 };
+    std::atomic<std::size_t> queueMax { 0 };
+    AtomicHistogram waitTime;
+    AtomicHistogram executionTime;
+};
+
+Duration Histogram::mean() const {
+    return count ? total / static_cast<Duration::rep>(count) : Duration::zero();
+}
+
+Duration Histogram::percentile(double p) const {
+    const double target = count * p / 100.0;
+    std::size_t seen = 0;
+    for (std::size_t i = 0; i < bucketCount; ++i) {
+        seen += buckets[i];
+        if (seen > 0 && seen >= target) {
+            return i + 1 == bucketCount ? max : std::chrono::microseconds(1ll << i);
+        }
+    }
+    return max;
+}
+
+Instrumentation::Instrumentation() = default;
+Instrumentation::~Instrumentation() = default;
+
+Instrumentation::Entry& Instrumentation::entry(const std::type_info& type) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& result = entries[std::type_index(type)];
+    if (!result) {
+        result = std::make_unique<Entry>();
+    }
+    return *result;
+}
+
+void Instrumentation::recordQueueLength(Entry& entry, std::size_t length) {
+    entry.queueSamples.fetch_add(1, std::memory_order_relaxed);
+    entry.queueTotal.fetch_add(length, std::memory_order_relaxed);
+
+    auto current = entry.queueMax.load(std::memory_order_relaxed);
+    while (length > current && !entry.queueMax.compare_exchange_weak(current, length, std::memory_order_relaxed)) {
+    }
+}
+
+void Instrumentation::recordWaitTime(Entry& entry, Duration duration) {
+    entry.waitTime.record(duration);
+}
+
+void Instrumentation::recordExecutionTime(Entry& entry, Duration duration) {
+    entry.executionTime.record(duration);
+}
+
+std::map<std::string, ActorStatistics> Instrumentation::snapshot() const {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    std::map<std::string, ActorStatistics> result;
+    for (const auto& pair : entries) {
+        const Entry& entry = *pair.second;
+        ActorStatistics& stats = result[demangle(pair.first.name())];
+
+        const std::size_t samples = entry.queueSamples.load(std::memory_order_relaxed);
+        stats.maxQueueLength = entry.queueMax.load(std::memory_order_relaxed);
+        stats.meanQueueLength = samples ? double(entry.queueTotal.load(std::memory_order_relaxed)) / samples : 0;
+        stats.waitTime = entry.waitTime.load();
+        stats.executionTime = entry.executionTime.load();
+        stats.messages = stats.executionTime.count;
+    }
+
+    return result;
+}
+
+} // namespace actor
+} // namespace mbgl
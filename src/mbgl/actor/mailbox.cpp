@@ -3,58 +3,188 @@
 #include <mbgl/actor/scheduler.hpp>
 
 #include <cassert>
+#include <thread>
 
 namespace mbgl {
 
+namespace {
+
+class StubMessage : public Message {
+public:
+    void operator()() override {}
+};
+
+} // namespace
+
 Mailbox::Mailbox(Scheduler& scheduler_)
-    : scheduler(scheduler_) {
+    : scheduler(scheduler_),
+      statistics(nullptr),
+      stub(std::make_unique<StubMessage>()),
+      head(stub.get()),
+      tail(stub.get()) {
+}
+
+Mailbox::Mailbox(Scheduler& scheduler_, const std::type_info& type)
+    : scheduler(scheduler_),
+      statistics(scheduler.getInstrumentation() ? &scheduler.getInstrumentation()->entry(type) : nullptr),
+      stub(std::make_unique<StubMessage>()),
+      head(stub.get()),
+      tail(stub.get()) {
+}
+
+Mailbox::~Mailbox() {
+    // Nobody can push anymore; discard the messages that were never received.
+    while (Message* message = pop()) {
+        delete message;
+    }
 }
 
 void Mailbox::push(std::unique_ptr<Message> message) {
     assert(!closing);
 
-    std::lock_guard<std::mutex> queueLock(queueMutex);
-    bool wasEmpty = queue.empty();
-    queue.push(std::move(message));
-    if (wasEmpty) {
-        scheduler.schedule(shared_from_this());
+    Message* node = message.release();
+    node->next.store(nullptr, std::memory_order_relaxed);
+    Message* prev = head.exchange(node, std::memory_order_acq_rel);
+    prev->next.store(node, std::memory_order_release);
+
+    const std::size_t previousSize = size.fetch_add(1);
+
+    if (statistics) {
+        actor::Instrumentation::recordQueueLength(*statistics, previousSize + 1);
     }
+
+    if (previousSize == 0) {
+        schedule();
+    }
+}
+
+void Mailbox::setPriority(Scheduler::Priority newPriority) {
+    const Scheduler::Priority oldPriority = priority.exchange(newPriority);
+    if (newPriority > oldPriority && queued) {
+        scheduler.scheduleWithPriority(shared_from_this(), newPriority);
+    }
+}
+
+void Mailbox::schedule() {
+    if (statistics) {
+        scheduledAt = Clock::now();
+    }
+
+    queued = true;
+    scheduler.scheduleWithPriority(shared_from_this(), priority);
 }
 
 void Mailbox::close() {
     // Block until the scheduler is guaranteed not to be executing receive().
-    std::lock_guard<std::mutex> closingLock(closingMutex);
     closing = true;
+
+    std::unique_lock<std::mutex> closingLock(closingMutex);
+    closingCondition.wait(closingLock, [this] {
+        return receiving == 0;
+    });
 }
 
-void Mailbox::receive() {
-    std::lock_guard<std::mutex> closingLock(closingMutex);
+void Mailbox::receive(const ReceiveQuantum& quantum) {
+    // This entry was superseded by one with a higher priority.
+    if (!queued.exchange(false)) {
+        return;
+    }
+
+    // `receiving` is raised before `closing` is checked, and `close()` raises `closing`
+    // before checking `receiving`, so at least one side observes the other.
+    receiving++;
+
+    bool reschedule = false;
+
+    if (!closing) {
+        const bool timed = quantum.maxDuration != Duration::max();
+        const TimePoint start = timed || statistics ? Clock::now() : TimePoint();
+
+        if (statistics) {
+            actor::Instrumentation::recordWaitTime(*statistics, start - scheduledAt);
+        }
+
+        std::size_t received = 0;
+
+        do {
+            // The message may have been counted by a producer that hasn't linked it yet.
+            Message* node;
+            while (!(node = pop())) {
+                std::this_thread::yield();
+            }
+
+            std::unique_ptr<Message> message(node);
+            if (statistics) {
+                const TimePoint before = Clock::now();
+                (*message)();
+                actor::Instrumentation::recordExecutionTime(*statistics, Clock::now() - before);
+            } else {
+                (*message)();
+            }
+            message.reset();
+
+            // Once the count drops to zero, a producer may schedule this mailbox again.
+            reschedule = size.fetch_sub(1) > 1;
+        } while (reschedule &&
+                 ++received < quantum.maxMessages &&
+                 !closing &&
+                 (!timed || Clock::now() - start < quantum.maxDuration));
+    }
+
+    receiving--;
 
     if (closing) {
-        return;
+        std::lock_guard<std::mutex> closingLock(closingMutex);
+        closingCondition.notify_all();
+    }
+
+    // Scheduling happens last: as soon as it is scheduled, receive() may run on another thread.
+    if (reschedule) {
+        schedule();
+    }
+}
+
+// Dmitry Vyukov's intrusive MPSC queue. Returns nullptr if the queue is empty or if
+// the next message is still being linked in by its producer.
+Message* Mailbox::pop() {
+    Message* first = tail;
+    Message* next = first->next.load(std::memory_order_acquire);
+
+    if (first == stub.get()) {
+        if (!next) {
+            return nullptr;
+        }
+        tail = first = next;
+        next = next->next.load(std::memory_order_acquire);
     }
 
-    std::unique_ptr<Message> message;
-    bool wasEmpty;
+    if (next) {
+        tail = next;
+        return first;
+    }
 
-    {
-        std::lock_guard<std::mutex> queueLock(queueMutex);
-        assert(!queue.empty());
-        message = std::move(queue.front());
-        queue.pop();
-        wasEmpty = queue.empty();
+    if (first != head.load(std::memory_order_acquire)) {
+        return nullptr;
     }
 
-    (*message)();
+    // `first` is the last message in the queue; put the stub back behind it so that
+    // it can be unlinked.
+    stub->next.store(nullptr, std::memory_order_relaxed);
+    Message* prev = head.exchange(stub.get(), std::memory_order_acq_rel);
+    prev->next.store(stub.get(), std::memory_order_release);
 
-    if (!wasEmpty) {
-        scheduler.schedule(shared_from_this());
+    next = first->next.load(std::memory_order_acquire);
+    if (next) {
+        tail = next;
+        return first;
     }
+
+    return nullptr;
 }
 
-void Mailbox::maybeReceive(std::weak_ptr<Mailbox> mailbox) {
+void Mailbox::maybeReceive(std::weak_ptr<Mailbox> mailbox, const ReceiveQuantum& quantum) {
     if (auto locked = mailbox.lock()) {
-        locked->receive();
+        locked->receive(quantum);
     }
 }
 
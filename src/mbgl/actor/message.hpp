@@ -1,5 +1,8 @@
 #pragma once
 
+#include <mbgl/actor/message_pool.hpp>
+
+#include <atomic>
 #include <utility>
 
 namespace mbgl {
@@ -11,6 +14,17 @@ class Message {
 public:
     virtual ~Message() = default;
     virtual void operator()() = 0;
+
+    static void* operator new(std::size_t size) {
+        return actor::allocateMessage(size);
+    }
+
+    static void operator delete(void* ptr) {
+        actor::deallocateMessage(ptr);
+    }
+
+    // Intrusive link used by the queue in `Mailbox`.
+    std::atomic<Message*> next { nullptr };
 };
 
 template <class Object, class MemberFn, class ArgsTuple>
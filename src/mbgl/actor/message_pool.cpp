@@ -0,0 +1,218 @@
+#include <mbgl/actor/message_pool.hpp>
+#include <mbgl/util/thread_local.hpp>
+
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <new>
+
+namespace mbgl {
+namespace actor {
+
+namespace {
+
+constexpr std::array<std::size_t, 3> blockSizes {{ 64, 128, 256 }};
+
+// Free blocks kept per block size and thread. Any excess goes back to the heap.
+constexpr std::size_t maxFreeBlocks = 256;
+
+// Block size index used for messages that don't fit in a pooled block.
+constexpr std::size_t unpooled = blockSizes.size();
+
+std::atomic<std::size_t> heapAllocations { 0 };
+std::atomic<std::size_t> pooledAllocations { 0 };
+
+class ThreadCache;
+
+struct alignas(16) Header {
+    ThreadCache* owner;
+    Header* next;
+    std::size_t sizeClass;
+};
+
+std::size_t sizeClassFor(std::size_t size) {
+    for (std::size_t i = 0; i < blockSizes.size(); ++i) {
+        if (size <= blockSizes[i]) {
+            return i;
+        }
+    }
+    return unpooled;
+}
+
+class ThreadCache {
+public:
+    Header* allocate(std::size_t sizeClass) {
+        if (!local[sizeClass]) {
+            reclaim();
+        }
+
+        if (Header* header = local[sizeClass]) {
+            local[sizeClass] = header->next;
+            localCount[sizeClass]--;
+            pooledAllocations.fetch_add(1, std::memory_order_relaxed);
+            return header;
+        }
+
+        blocks.fetch_add(1, std::memory_order_relaxed);
+        heapAllocations.fetch_add(1, std::memory_order_relaxed);
+        Header* header = static_cast<Header*>(::operator new(sizeof(Header) + blockSizes[sizeClass]));
+        header->owner = this;
+        header->sizeClass = sizeClass;
+        return header;
+    }
+
+    // Must be called on the owning thread.
+    void deallocate(Header* header) {
+        const std::size_t sizeClass = header->sizeClass;
+        if (localCount[sizeClass] < maxFreeBlocks) {
+            header->next = local[sizeClass];
+            local[sizeClass] = header;
+            localCount[sizeClass]++;
+        } else {
+            destroy(header);
+        }
+    }
+
+    // Called on any other thread.
+    void deallocateRemote(Header* header) {
+        // Keep this cache alive in case the owning thread exits and frees the block concurrently.
+        blocks.fetch_add(1, std::memory_order_relaxed);
+
+        Header* head = remote.load(std::memory_order_relaxed);
+        do {
+            header->next = head;
+        } while (!remote.compare_exchange_weak(head, header, std::memory_order_acq_rel, std::memory_order_relaxed));
+
+        // If the owning thread is gone, nobody is going to reclaim the block.
+        if (abandoned) {
+            for (Header* it = remote.exchange(nullptr, std::memory_order_acquire); it;) {
+                Header* next = it->next;
+                destroy(it);
+                it = next;
+            }
+        }
+
+        release();
+    }
+
+    // Called when the owning thread exits.
+    void abandon() {
+        abandoned = true;
+
+        for (std::size_t i = 0; i < blockSizes.size(); ++i) {
+            while (Header* header = local[i]) {
+                local[i] = header->next;
+                destroy(header);
+            }
+        }
+
+        for (Header* it = remote.exchange(nullptr, std::memory_order_acquire); it;) {
+            Header* next = it->next;
+            destroy(it);
+            it = next;
+        }
+
+        release();
+    }
+
+private:
+    // Moves the blocks that were freed on other threads to the local free lists.
+    void reclaim() {
+        for (Header* it = remote.exchange(nullptr, std::memory_order_acquire); it;) {
+            Header* next = it->next;
+            deallocate(it);
+            it = next;
+        }
+    }
+
+    void destroy(Header* header) {
+        ::operator delete(header);
+        release();
+    }
+
+    void release() {
+        if (blocks.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            delete this;
+        }
+    }
+
+    std::array<Header*, blockSizes.size()> local {{}};
+    std::array<std::size_t, blockSizes.size()> localCount {{}};
+
+    std::atomic<Header*> remote { nullptr };
+    std::atomic<bool> abandoned { false };
+
+    // Blocks that are allocated from the heap and not yet returned to it, plus one for as
+    // long as the owning thread is alive.
+    std::atomic<std::size_t> blocks { 1 };
+};
+
+// Abandons the cache of a thread when the thread exits.
+class ThreadCacheHandle {
+public:
+    ThreadCache* const cache = new ThreadCache;
+
+    ~ThreadCacheHandle() {
+        cache->abandon();
+    }
+};
+
+util::ThreadLocal<ThreadCacheHandle>& threadCaches() {
+    // Intentionally leaked: messages may still be freed on other threads during exit.
+    static auto caches = new util::ThreadLocal<ThreadCacheHandle>;
+    return *caches;
+}
+
+} // namespace
+
+void* allocateMessage(std::size_t size) {
+    const std::size_t sizeClass = sizeClassFor(size);
+    Header* header;
+
+    if (sizeClass == unpooled) {
+        heapAllocations.fetch_add(1, std::memory_order_relaxed);
+        header = static_cast<Header*>(::operator new(sizeof(Header) + size));
+        header->owner = nullptr;
+        header->sizeClass = unpooled;
+    } else {
+        auto& caches = threadCaches();
+        ThreadCacheHandle* handle = caches.get();
+        if (!handle) {
+            handle = new ThreadCacheHandle;
+            caches.set(handle);
+        }
+        header = handle->cache->allocate(sizeClass);
+    }
+
+    return header + 1;
+}
+
+void deallocateMessage(void* ptr) {
+    if (!ptr) {
+        return;
+    }
+
+    Header* header = static_cast<Header*>(ptr) - 1;
+
+    if (!header->owner) {
+        ::operator delete(header);
+        return;
+    }
+
+    ThreadCacheHandle* handle = threadCaches().get();
+    if (handle && handle->cache == header->owner) {
+        header->owner->deallocate(header);
+    } else {
+        header->owner->deallocateRemote(header);
+    }
+}
+
+MessageAllocations messageAllocations() {
+    return {
+        heapAllocations.load(std::memory_order_relaxed),
+        pooledAllocations.load(std::memory_order_relaxed)
+    };
+}
+
+} // namespace actor
+} // namespace mbgl
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+
+namespace mbgl {
+namespace actor {
+
+/*
+    Messages are typically allocated on one thread and freed on another, after they've been
+    received. To avoid hitting the global allocator for every message, small messages are
+    allocated from a per-thread pool of fixed-size blocks. A block freed on its owning thread
+    goes straight back to that thread's pool; a block freed on any other thread is handed
+    back to its owner through a lock-free list, and reclaimed once the owner's pool runs dry.
+
+    Messages larger than the largest block size are allocated from the heap.
+*/
+
+void* allocateMessage(std::size_t size);
+void deallocateMessage(void* ptr);
+
+// Total number of messages allocated from the heap and from a pool, for instrumentation.
+class MessageAllocations {
+public:
+    std::size_t heap;
+    std::size_t pooled;
+};
+
+MessageAllocations messageAllocations();
+
+} // namespace actor
+} // namespace mbgl
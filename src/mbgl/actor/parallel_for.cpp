@@ -0,0 +1,106 @@
+#include <mbgl/actor/parallel_for.hpp>
+#include <mbgl/actor/actor.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mbgl {
+
+namespace {
+
+class ForkJoin {
+public:
+    ForkJoin(std::size_t count_, const std::function<void (std::size_t)>& task_)
+        : count(count_), task(task_) {
+    }
+
+    // Runs tasks until there are none left to claim.
+    void drain() {
+        for (std::size_t i = next++; i < count; i = next++) {
+            std::exception_ptr taskError;
+            try {
+                task(i);
+            } catch (...) {
+                taskError = std::current_exception();
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+            if (taskError && !error) {
+                error = taskError;
+            }
+            if (++finished == count) {
+                condition.notify_all();
+            }
+        }
+    }
+
+    // Waits for tasks claimed by other threads to finish.
+    void join() {
+        std::unique_lock<std::mutex> lock(mutex);
+        condition.wait(lock, [&] { return finished == count; });
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+private:
+    const std::size_t count;
+    const std::function<void (std::size_t)>& task;
+
+    std::atomic<std::size_t> next { 0 };
+
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::size_t finished = 0;
+    std::exception_ptr error;
+};
+
+class ParallelForHelper {
+public:
+    ParallelForHelper(ActorRef<ParallelForHelper>, ForkJoin& forkJoin_)
+        : forkJoin(forkJoin_) {
+    }
+
+    void run() {
+        forkJoin.drain();
+    }
+
+private:
+    ForkJoin& forkJoin;
+};
+
+} // namespace
+
+void parallelFor(Scheduler& scheduler, std::size_t count, const std::function<void (std::size_t)>& task) {
+    if (count == 0) {
+        return;
+    }
+
+    ForkJoin forkJoin(count, task);
+
+    // The calling thread is one of the workers, so there is no point in having more
+    // helpers than there are other tasks or other cores.
+    const std::size_t cores = std::thread::hardware_concurrency();
+    const std::size_t helperCount = std::min(count - 1, cores > 1 ? cores - 1 : 0);
+
+    std::vector<std::unique_ptr<Actor<ParallelForHelper>>> helpers;
+    helpers.reserve(helperCount);
+    for (std::size_t i = 0; i < helperCount; ++i) {
+        helpers.push_back(std::make_unique<Actor<ParallelForHelper>>(scheduler, forkJoin));
+        helpers.back()->invoke(&ParallelForHelper::run);
+    }
+
+    forkJoin.drain();
+    forkJoin.join();
+
+    // `helpers` is destroyed before `forkJoin`, including when `join` throws. Destroying a
+    // helper waits for it to return if it is running, and discards its message if it
+    // hasn't started yet.
+}
+
+} // namespace mbgl
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+namespace mbgl {
+
+class Scheduler;
+
+/*
+    Runs `task(0)` through `task(count - 1)` and returns once all of them have finished,
+    rethrowing the first exception thrown by a task, if any.
+
+    Tasks are claimed one at a time by the calling thread and by short-lived helper actors
+    on `scheduler`. The calling thread takes part in the work, so this makes progress even
+    when it is itself running on the only thread of `scheduler`; helpers that haven't
+    started by the time all tasks are done are discarded.
+
+    Tasks may run concurrently and in any order, so they must not share mutable state.
+*/
+void parallelFor(Scheduler&, std::size_t count, const std::function<void (std::size_t)>& task);
+
+} // namespace mbgl
@@ -19,8 +19,6 @@ AnnotationTile::~AnnotationTile() {
     annotationManager.removeTile(*this);
 }
 
-void AnnotationTile::setNecessity(Necessity) {}
-
 AnnotationTileFeature::AnnotationTileFeature(const AnnotationID id_,
                                              FeatureType type_, GeometryCollection geometries_,
                                              std::unordered_map<std::string, std::string> properties_)
@@ -40,10 +38,31 @@ optional<Value> AnnotationTileFeature::getValue(const std::string& key) const {
 AnnotationTileLayer::AnnotationTileLayer(std::string name_)
     : name(std::move(name_)) {}
 
+void AnnotationTileLayer::eachFeature(const FeatureVisitor& visitor) const {
+    for (std::size_t i = 0; i < features.size(); i++) {
+        if (!visitor(i, features[i])) {
+            return;
+        }
+    }
+}
+
 std::unique_ptr<GeometryTileData> AnnotationTileData::clone() const {
     return std::make_unique<AnnotationTileData>(*this);
 }
 
+std::size_t AnnotationTileData::bytes() const {
+    std::size_t result = 0;
+    for (const auto& layer : layers) {
+        for (const auto& feature : layer.second.features) {
+            result += sizeof(AnnotationTileFeature);
+            for (const auto& geometry : feature.geometries) {
+                result += geometry.size() * sizeof(GeometryCoordinate);
+            }
+        }
+    }
+    return result;
+}
+
 const GeometryTileLayer* AnnotationTileData::getLayer(const std::string& name) const {
     auto it = layers.find(name);
     if (it != layers.end()) {
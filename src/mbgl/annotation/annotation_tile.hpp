@@ -18,8 +18,6 @@ public:
                    const style::UpdateParameters&);
     ~AnnotationTile() override;
 
-    void setNecessity(Necessity) final;
-
 private:
     AnnotationManager& annotationManager;
 };
@@ -50,6 +48,8 @@ public:
         return std::make_unique<AnnotationTileFeature>(features.at(i));
     }
 
+    void eachFeature(const FeatureVisitor&) const override;
+
     std::string getName() const override { return name; };
 
     std::vector<AnnotationTileFeature> features;
@@ -62,6 +62,7 @@ class AnnotationTileData : public GeometryTileData {
 public:
     std::unique_ptr<GeometryTileData> clone() const override;
     const GeometryTileLayer* getLayer(const std::string&) const override;
+    std::size_t bytes() const override;
 
     std::unordered_map<std::string, AnnotationTileLayer> layers;
 };
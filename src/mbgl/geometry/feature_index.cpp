@@ -27,11 +27,17 @@ void FeatureIndex::insert(const GeometryCollection& geometries,
                           const std::string& sourceLayerName,
                           const std::string& bucketName) {
     for (const auto& ring : geometries) {
-        grid.insert(IndexedSubfeature { index, sourceLayerName, bucketName, sortIndex++ },
-                    mapbox::geometry::envelope(ring));
+        insert(mapbox::geometry::envelope(ring), index, sourceLayerName, bucketName);
     }
 }
 
+void FeatureIndex::insert(const GridIndex<IndexedSubfeature>::BBox& envelope,
+                          std::size_t index,
+                          const std::string& sourceLayerName,
+                          const std::string& bucketName) {
+    grid.insert(IndexedSubfeature { index, sourceLayerName, bucketName, sortIndex++ }, envelope);
+}
+
 static bool vectorContains(const std::vector<std::string>& vector, const std::string& s) {
     return std::find(vector.begin(), vector.end(), s) != vector.end();
 }
@@ -162,4 +168,12 @@ void FeatureIndex::setBucketLayerIDs(const std::string& bucketName, const std::v
     bucketLayerIDs[bucketName] = layerIDs;
 }
 
+std::size_t FeatureIndex::bytes() const {
+    std::size_t result = sizeof(FeatureIndex) + grid.bytes();
+    for (const auto& pair : bucketLayerIDs) {
+        result += pair.first.capacity() + pair.second.capacity() * sizeof(std::string);
+    }
+    return result;
+}
+
 } // namespace mbgl
@@ -35,6 +35,9 @@ public:
 
     void insert(const GeometryCollection&, std::size_t index, const std::string& sourceLayerName, const std::string& bucketName);
 
+    // Inserts a single ring by its precomputed envelope.
+    void insert(const GridIndex<IndexedSubfeature>::BBox&, std::size_t index, const std::string& sourceLayerName, const std::string& bucketName);
+
     void query(
             std::unordered_map<std::string, std::vector<Feature>>& result,
             const GeometryCoordinates& queryGeometry,
@@ -56,6 +59,9 @@ public:
 
     void setBucketLayerIDs(const std::string& bucketName, const std::vector<std::string>& layerIDs);
 
+    // An estimate of the memory used by the index.
+    std::size_t bytes() const;
+
 private:
     void addFeature(
             std::unordered_map<std::string, std::vector<Feature>>& result,
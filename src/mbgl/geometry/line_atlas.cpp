@@ -121,6 +121,13 @@ Size LineAtlas::getSize() const {
     return image.size;
 }
 
+MemoryUsage LineAtlas::memoryUsage() const {
+    MemoryUsage result;
+    result.cpu = image.bytes();
+    result.gpu = texture ? image.bytes() : 0;
+    return result;
+}
+
 void LineAtlas::upload(gl::Context& context, gl::TextureUnit unit) {
     if (!texture) {
         texture = context.createTexture(image, unit);
@@ -2,6 +2,7 @@
 
 #include <mbgl/gl/texture.hpp>
 #include <mbgl/gl/object.hpp>
+#include <mbgl/map/memory_usage.hpp>
 #include <mbgl/util/image.hpp>
 #include <mbgl/util/optional.hpp>
 
@@ -44,6 +45,8 @@ public:
 
     Size getSize() const;
 
+    MemoryUsage memoryUsage() const;
+
 private:
     const AlphaImage image;
     bool dirty;
@@ -38,6 +38,15 @@ static_assert(underlying_type(TextureFormat::Alpha) == GL_ALPHA, "OpenGL type mi
 
 static_assert(std::is_same<BinaryProgramFormat, GLenum>::value, "OpenGL type mismatch");
 
+// Forgets the size of a deleted buffer or texture.
+static void releaseSize(std::unordered_map<GLuint, std::size_t>& sizes, std::size_t& bytes, GLuint id) {
+    auto it = sizes.find(id);
+    if (it != sizes.end()) {
+        bytes -= it->second;
+        sizes.erase(it);
+    }
+}
+
 Context::Context() = default;
 
 Context::~Context() {
@@ -170,6 +179,8 @@ UniqueBuffer Context::createVertexBuffer(const void* data, std::size_t size) {
     UniqueBuffer result { std::move(id), { this } };
     vertexBuffer = result;
     MBGL_CHECK_ERROR(glBufferData(GL_ARRAY_BUFFER, size, data, GL_STATIC_DRAW));
+    bufferSizes[result.get()] = size;
+    bufferBytes += size;
     return result;
 }
 
@@ -180,6 +191,8 @@ UniqueBuffer Context::createIndexBuffer(const void* data, std::size_t size) {
     vertexArrayObject = 0;
     elementBuffer = result;
     MBGL_CHECK_ERROR(glBufferData(GL_ELEMENT_ARRAY_BUFFER, size, data, GL_STATIC_DRAW));
+    bufferSizes[result.get()] = size;
+    bufferBytes += size;
     return result;
 }
 
@@ -404,6 +417,12 @@ void Context::updateTexture(
     MBGL_CHECK_ERROR(glTexImage2D(GL_TEXTURE_2D, 0, static_cast<GLenum>(format), size.width,
                                   size.height, 0, static_cast<GLenum>(format), GL_UNSIGNED_BYTE,
                                   data));
+
+    // Respecifying a texture replaces its storage.
+    std::size_t& textureSize = textureSizes[id];
+    textureBytes -= textureSize;
+    textureSize = size.area() * (format == TextureFormat::RGBA ? 4 : 1);
+    textureBytes += textureSize;
 }
 
 void Context::bindTexture(Texture& obj,
@@ -613,6 +632,7 @@ void Context::performCleanup() {
             } else if (elementBuffer == id) {
                 elementBuffer.setDirty();
             }
+            releaseSize(bufferSizes, bufferBytes, id);
         }
         MBGL_CHECK_ERROR(glDeleteBuffers(int(abandonedBuffers.size()), abandonedBuffers.data()));
         abandonedBuffers.clear();
@@ -623,6 +643,7 @@ void Context::performCleanup() {
             if (activeTexture == id) {
                 activeTexture.setDirty();
             }
+            releaseSize(textureSizes, textureBytes, id);
         }
         MBGL_CHECK_ERROR(glDeleteTextures(int(abandonedTextures.size()), abandonedTextures.data()));
         abandonedTextures.clear();
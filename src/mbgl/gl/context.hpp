@@ -22,6 +22,7 @@
 #include <vector>
 #include <array>
 #include <string>
+#include <unordered_map>
 
 namespace mbgl {
 
@@ -75,6 +76,7 @@ public:
     template <class DrawMode>
     IndexBuffer<DrawMode> createIndexBuffer(IndexVector<DrawMode>&& v) {
         return IndexBuffer<DrawMode> {
+            v.indexSize(),
             createIndexBuffer(v.data(), v.byteSize())
         };
     }
@@ -184,6 +186,16 @@ public:
         return vertexArray.get();
     }
 
+    // The memory used by the buffers and textures created through this context, until they
+    // are deleted. Pooled textures keep their storage until they are reused or deleted.
+    std::size_t getBufferBytes() const {
+        return bufferBytes;
+    }
+
+    std::size_t getTextureBytes() const {
+        return textureBytes;
+    }
+
 private:
     std::unique_ptr<extension::Debugging> debugging;
     std::unique_ptr<extension::VertexArray> vertexArray;
@@ -262,6 +274,11 @@ private:
     std::vector<FramebufferID> abandonedFramebuffers;
     std::vector<RenderbufferID> abandonedRenderbuffers;
 
+    std::unordered_map<BufferID, std::size_t> bufferSizes;
+    std::unordered_map<TextureID, std::size_t> textureSizes;
+    std::size_t bufferBytes = 0;
+    std::size_t textureBytes = 0;
+
 public:
     // For testing
     bool disableVAOExtension = false;
@@ -33,7 +33,10 @@ private:
 template <class DrawMode>
 class IndexBuffer {
 public:
+    std::size_t indexCount;
     UniqueBuffer buffer;
+
+    std::size_t byteSize() const { return indexCount * sizeof(uint16_t); }
 };
 
 } // namespace gl
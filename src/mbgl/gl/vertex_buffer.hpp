@@ -40,6 +40,8 @@ public:
 
     std::size_t vertexCount;
     UniqueBuffer buffer;
+
+    std::size_t byteSize() const { return vertexCount * vertexSize; }
 };
 
 } // namespace gl
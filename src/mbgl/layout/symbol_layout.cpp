@@ -2,7 +2,7 @@
 #include <mbgl/layout/merge_lines.hpp>
 #include <mbgl/layout/clip_lines.hpp>
 #include <mbgl/renderer/symbol_bucket.hpp>
-#include <mbgl/style/filter_evaluator.hpp>
+#include <mbgl/style/compiled_filter.hpp>
 #include <mbgl/style/bucket_parameters.hpp>
 #include <mbgl/style/layers/symbol_layer.hpp>
 #include <mbgl/style/layers/symbol_layer_impl.hpp>
@@ -93,14 +93,14 @@ SymbolLayout::SymbolLayout(const BucketParameters& parameters,
         ));
     }
 
-    // Determine and load glyph ranges
-    const size_t featureCount = sourceLayer.featureCount();
-    for (size_t i = 0; i < featureCount; ++i) {
-        auto feature = sourceLayer.getFeature(i);
-        if (!leader.filter(feature->getType(), feature->getID(), [&] (const auto& key) { return feature->getValue(key); }))
-            continue;
-        
-        SymbolFeature ft(std::move(feature));
+    // Determine and load glyph ranges. Filter on the transient feature, and only
+    // take an owning copy of the features that pass.
+    const CompiledFilter filter(leader.filter, sourceLayer);
+    sourceLayer.eachFeature([&] (std::size_t i, const GeometryTileFeature& feature) {
+        if (!filter(feature))
+            return true;
+
+        SymbolFeature ft(sourceLayer.getFeature(i));
 
         ft.index = i;
 
@@ -153,7 +153,9 @@ SymbolLayout::SymbolLayout(const BucketParameters& parameters,
         if (ft.text || ft.icon) {
             features.push_back(std::move(ft));
         }
-    }
+
+        return true;
+    });
 
     if (layout.get<SymbolPlacement>() == SymbolPlacementType::Line) {
         util::mergeLines(features);
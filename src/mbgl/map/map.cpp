@@ -101,6 +101,8 @@ public:
     std::unique_ptr<AsyncRequest> styleRequest;
 
     size_t sourceCacheSize;
+    std::size_t sourceCacheBytes = 0;
+    bool sharedSourceCache = false;
     bool loading = false;
 
     util::AsyncTask asyncInvalidate;
@@ -261,7 +263,8 @@ void Map::Impl::render(View& view) {
                                        fileSource,
                                        mode,
                                        *annotationManager,
-                                       *style);
+                                       *style,
+                                       transform.getPrefetchStates());
 
     style->updateTiles(parameters);
 
@@ -413,6 +416,7 @@ void Map::setStyleJSON(const std::string& json) {
 
 void Map::Impl::loadStyleJSON(const std::string& json) {
     style->setObserver(this);
+    style->setSourceTileCacheBytes(sourceCacheBytes, sharedSourceCache);
     style->setJSON(json);
     styleJSON = json;
 
@@ -1100,6 +1104,16 @@ void Map::setSourceTileCacheSize(size_t size) {
     }
 }
 
+void Map::setSourceTileCacheBytes(std::size_t bytes, bool shared) {
+    if (bytes != impl->sourceCacheBytes || shared != impl->sharedSourceCache) {
+        impl->sourceCacheBytes = bytes;
+        impl->sharedSourceCache = shared;
+        if (!impl->style) return;
+        impl->style->setSourceTileCacheBytes(bytes, shared);
+        impl->backend.invalidate();
+    }
+}
+
 void Map::onLowMemory() {
     if (impl->painter) {
         BackendScope guard(impl->backend);
@@ -1111,6 +1125,24 @@ void Map::onLowMemory() {
     }
 }
 
+MapMemoryUsage Map::getMemoryUsage() const {
+    MapMemoryUsage result;
+    if (impl->style) {
+        result = impl->style->getMemoryUsage();
+    }
+
+    // The context is set up along with the painter on the first render; until then, it
+    // holds no buffers or textures.
+    if (impl->painter) {
+        BackendScope guard(impl->backend);
+        gl::Context& context = impl->backend.getContext();
+        result.bufferBytes = context.getBufferBytes();
+        result.textureBytes = context.getTextureBytes();
+    }
+
+    return result;
+}
+
 void Map::Impl::onSourceChanged(style::Source& source) {
     observer.onSourceChanged(source);
 }
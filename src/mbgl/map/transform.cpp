@@ -12,6 +12,7 @@
 #include <mbgl/util/logging.hpp>
 #include <mbgl/util/platform.hpp>
 
+#include <algorithm>
 #include <cstdio>
 #include <cmath>
 
@@ -565,6 +566,19 @@ void Transform::startTransition(const CameraOptions& camera,
     transitionStart = Clock::now();
     transitionDuration = duration;
 
+    // Sample the camera along the path by running the frame function ahead of time.
+    prefetchSamples.clear();
+    if (isAnimated) {
+        const TransformState current = state;
+        for (std::size_t i = 1; i <= util::PREFETCH_SAMPLES; ++i) {
+            const double k = double(i) / util::PREFETCH_SAMPLES;
+            frame(k);
+            if (anchor) state.moveLatLng(anchorLatLng, *anchor);
+            prefetchSamples.emplace_back(k, state);
+            state = current;
+        }
+    }
+
     transitionFrameFn = [isAnimated, animation, frame, anchor, anchorLatLng, this](const TimePoint now) {
         float t = isAnimated ? (std::chrono::duration<float>(now - transitionStart) / transitionDuration) : 1.0;
         Update result;
@@ -572,7 +586,13 @@ void Transform::startTransition(const CameraOptions& camera,
             result = frame(1.0);
         } else {
             util::UnitBezier ease = animation.easing ? *animation.easing : util::DEFAULT_TRANSITION_EASE;
-            result = frame(ease.solve(t, 0.001));
+            const double k = ease.solve(t, 0.001);
+            result = frame(k);
+
+            // Stop prefetching for the part of the path that the camera has passed.
+            auto passed = std::find_if(prefetchSamples.begin(), prefetchSamples.end(),
+                                       [&](const auto& sample) { return sample.first > k; });
+            prefetchSamples.erase(prefetchSamples.begin(), passed);
         }
 
         if (anchor) state.moveLatLng(anchorLatLng, *anchor);
@@ -595,6 +615,7 @@ void Transform::startTransition(const CameraOptions& camera,
     };
 
     transitionFinishFn = [isAnimated, animation, this] {
+        prefetchSamples.clear();
         state.panning = false;
         state.scaling = false;
         state.rotating = false;
@@ -626,6 +647,15 @@ void Transform::cancelTransitions() {
     transitionFinishFn = nullptr;
 }
 
+std::vector<TransformState> Transform::getPrefetchStates() const {
+    std::vector<TransformState> result;
+    result.reserve(prefetchSamples.size());
+    for (const auto& sample : prefetchSamples) {
+        result.push_back(sample.second);
+    }
+    return result;
+}
+
 void Transform::setGestureInProgress(bool inProgress) {
     state.gestureInProgress = inProgress;
 }
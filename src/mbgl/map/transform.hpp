@@ -13,6 +13,8 @@
 #include <cstdint>
 #include <cmath>
 #include <functional>
+#include <utility>
+#include <vector>
 
 namespace mbgl {
 
@@ -150,6 +152,11 @@ public:
     Duration getTransitionDuration() const { return transitionDuration; }
     void cancelTransitions();
 
+    // The camera states that the current animation has yet to pass through, ending with its
+    // destination, so that the tiles they show can be loaded ahead of time. Empty when no
+    // animation is running.
+    std::vector<TransformState> getPrefetchStates() const;
+
     // Gesture
     void setGestureInProgress(bool);
     bool isGestureInProgress() const { return state.isGestureInProgress(); }
@@ -177,6 +184,9 @@ private:
     Duration transitionDuration;
     std::function<Update(const TimePoint)> transitionFrameFn;
     std::function<void()> transitionFinishFn;
+
+    // Camera states sampled along the current animation, with their progress along it.
+    std::vector<std::pair<double, TransformState>> prefetchSamples;
 };
 
 } // namespace mbgl
@@ -1,7 +1,9 @@
 #pragma once
 
 #include <mbgl/renderer/render_pass.hpp>
+#include <mbgl/map/memory_usage.hpp>
 #include <mbgl/util/noncopyable.hpp>
+#include <mbgl/util/optional.hpp>
 #include <mbgl/tile/geometry_tile_data.hpp>
 
 #include <atomic>
@@ -38,11 +40,21 @@ public:
 
     virtual bool hasData() const = 0;
 
+    // The memory used by the bucket's vertices, indices and images while they are waiting to
+    // be uploaded, or kept afterwards, and by the buffers and textures they are uploaded to.
+    virtual MemoryUsage memoryUsage() const = 0;
+
     bool needsUpload() const {
         return !uploaded;
     }
 
 protected:
+    template <class Buffer>
+    static std::size_t byteSize(const optional<Buffer>& buffer) {
+        return buffer ? buffer->byteSize() : 0;
+    }
+
+
     std::atomic<bool> uploaded { false };
 };
 
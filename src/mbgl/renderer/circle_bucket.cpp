@@ -44,6 +44,16 @@ bool CircleBucket::hasData() const {
     return !segments.empty();
 }
 
+MemoryUsage CircleBucket::memoryUsage() const {
+    MemoryUsage result;
+    result.cpu = vertices.byteSize() + triangles.byteSize();
+    result.gpu = byteSize(vertexBuffer) + byteSize(indexBuffer);
+    for (const auto& pair : paintPropertyBinders) {
+        result += pair.second.memoryUsage();
+    }
+    return result;
+}
+
 void CircleBucket::addFeature(const GeometryTileFeature& feature,
                               const GeometryCollection& geometry) {
     constexpr const uint16_t vertexLength = 4;
@@ -131,4 +131,14 @@ bool FillBucket::hasData() const {
     return !triangleSegments.empty() || !lineSegments.empty();
 }
 
+MemoryUsage FillBucket::memoryUsage() const {
+    MemoryUsage result;
+    result.cpu = vertices.byteSize() + lines.byteSize() + triangles.byteSize();
+    result.gpu = byteSize(vertexBuffer) + byteSize(lineIndexBuffer) + byteSize(triangleIndexBuffer);
+    for (const auto& pair : paintPropertyBinders) {
+        result += pair.second.memoryUsage();
+    }
+    return result;
+}
+
 } // namespace mbgl
@@ -460,4 +460,14 @@ bool LineBucket::hasData() const {
     return !segments.empty();
 }
 
+MemoryUsage LineBucket::memoryUsage() const {
+    MemoryUsage result;
+    result.cpu = vertices.byteSize() + triangles.byteSize();
+    result.gpu = byteSize(vertexBuffer) + byteSize(indexBuffer);
+    for (const auto& pair : paintPropertyBinders) {
+        result += pair.second.memoryUsage();
+    }
+    return result;
+}
+
 } // namespace mbgl
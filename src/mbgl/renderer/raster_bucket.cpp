@@ -27,4 +27,12 @@ bool RasterBucket::hasData() const {
     return true;
 }
 
+MemoryUsage RasterBucket::memoryUsage() const {
+    // The image is kept after it is uploaded.
+    MemoryUsage result;
+    result.cpu = image.valid() ? image.bytes() : 0;
+    result.gpu = texture ? texture->size.area() * 4 : 0;
+    return result;
+}
+
 } // namespace mbgl
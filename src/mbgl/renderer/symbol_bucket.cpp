@@ -64,6 +64,22 @@ bool SymbolBucket::hasData() const {
     return false;
 }
 
+MemoryUsage SymbolBucket::memoryUsage() const {
+    MemoryUsage result;
+    result.cpu =
+        text.vertices.byteSize() + text.triangles.byteSize() +
+        icon.vertices.byteSize() + icon.triangles.byteSize() +
+        collisionBox.vertices.byteSize() + collisionBox.lines.byteSize();
+    result.gpu =
+        byteSize(text.vertexBuffer) + byteSize(text.indexBuffer) +
+        byteSize(icon.vertexBuffer) + byteSize(icon.indexBuffer) +
+        byteSize(collisionBox.vertexBuffer) + byteSize(collisionBox.indexBuffer);
+    for (const auto& pair : paintPropertyBinders) {
+        result += pair.second.first.memoryUsage() + pair.second.second.memoryUsage();
+    }
+    return result;
+}
+
 bool SymbolBucket::hasTextData() const {
     return !text.segments.empty();
 }
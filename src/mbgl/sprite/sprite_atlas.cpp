@@ -285,6 +285,20 @@ void SpriteAtlas::copy(const Entry& entry, optional<Rect<uint16_t>> Entry::*entr
     dirty = true;
 }
 
+MemoryUsage SpriteAtlas::memoryUsage() const {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // The image is allocated when the first sprite is copied into it.
+    MemoryUsage result;
+    result.cpu = image.valid() ? image.bytes() : 0;
+    result.gpu = texture ? texture->size.area() * 4 : 0;
+    for (const auto& pair : entries) {
+        result.cpu += pair.second.spriteImage->image.bytes();
+    }
+
+    return result;
+}
+
 void SpriteAtlas::upload(gl::Context& context, gl::TextureUnit unit) {
     if (!texture) {
         texture = context.createTexture(image, unit);
@@ -5,6 +5,7 @@
 #include <mbgl/util/noncopyable.hpp>
 #include <mbgl/util/optional.hpp>
 #include <mbgl/sprite/sprite_image.hpp>
+#include <mbgl/map/memory_usage.hpp>
 
 #include <atomic>
 #include <string>
@@ -71,6 +72,9 @@ public:
     Size getSize() const { return size; }
     float getPixelRatio() const { return pixelRatio; }
 
+    // The memory used by the atlas and by the sprite images it holds.
+    MemoryUsage memoryUsage() const;
+
     // Only for use in tests.
     void setSprites(const Sprites& sprites);
     const PremultipliedImage& getAtlasImage() const {
@@ -106,7 +110,7 @@ private:
     optional<SpriteAtlasElement> getImage(const std::string& name, optional<Rect<uint16_t>> Entry::*rect);
     void copy(const Entry&, optional<Rect<uint16_t>> Entry::*rect);
 
-    std::mutex mutex;
+    mutable std::mutex mutex;
     std::unordered_map<std::string, Entry> entries;
     BinPack<uint16_t> bin;
     PremultipliedImage image;
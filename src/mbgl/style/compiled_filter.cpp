@@ -0,0 +1,176 @@
+#include <mbgl/style/compiled_filter.hpp>
+#include <mbgl/style/filter_evaluator.hpp>
+#include <mbgl/tile/geometry_tile_data.hpp>
+
+namespace mbgl {
+namespace style {
+
+// Builds nodes bottom-up, so operands always precede the node that uses them
+// and the root is the last node.
+class CompiledFilter::Compiler {
+public:
+    std::vector<Node>& nodes;
+    const GeometryTileLayer& layer;
+    const std::vector<Value>* values;
+
+    std::size_t compile(const Filter& filter) {
+        Node node = values ? Filter::visit(filter, Visitor { *this, filter }) : generic(filter);
+        nodes.push_back(std::move(node));
+        return nodes.size() - 1;
+    }
+
+private:
+    struct Visitor {
+        Compiler& compiler;
+        const Filter& filter;
+
+        Node operator()(const NullFilter&) const { return compiler.constant(true); }
+
+        Node operator()(const EqualsFilter& f) const { return compiler.property(filter, f.key); }
+        Node operator()(const NotEqualsFilter& f) const { return compiler.property(filter, f.key); }
+        Node operator()(const LessThanFilter& f) const { return compiler.property(filter, f.key); }
+        Node operator()(const LessThanEqualsFilter& f) const { return compiler.property(filter, f.key); }
+        Node operator()(const GreaterThanFilter& f) const { return compiler.property(filter, f.key); }
+        Node operator()(const GreaterThanEqualsFilter& f) const { return compiler.property(filter, f.key); }
+        Node operator()(const InFilter& f) const { return compiler.property(filter, f.key); }
+        Node operator()(const NotInFilter& f) const { return compiler.property(filter, f.key); }
+        Node operator()(const HasFilter& f) const { return compiler.property(filter, f.key); }
+        Node operator()(const NotHasFilter& f) const { return compiler.property(filter, f.key); }
+
+        Node operator()(const TypeEqualsFilter&) const { return compiler.type(filter); }
+        Node operator()(const TypeNotEqualsFilter&) const { return compiler.type(filter); }
+        Node operator()(const TypeInFilter&) const { return compiler.type(filter); }
+        Node operator()(const TypeNotInFilter&) const { return compiler.type(filter); }
+
+        Node operator()(const AnyFilter& f) const { return compiler.combination(Node::Kind::Any, f.filters); }
+        Node operator()(const AllFilter& f) const { return compiler.combination(Node::Kind::All, f.filters); }
+        Node operator()(const NoneFilter& f) const { return compiler.combination(Node::Kind::None, f.filters); }
+
+        template <class T>
+        Node operator()(const T&) const { return compiler.generic(filter); }
+    };
+
+    Node generic(const Filter& filter) {
+        Node node;
+        node.kind = Node::Kind::Generic;
+        node.filter = &filter;
+        return node;
+    }
+
+    Node constant(bool result) {
+        Node node;
+        node.kind = Node::Kind::Constant;
+        node.missing = result;
+        return node;
+    }
+
+    // Evaluates the clause once against every value in the layer's value table, and
+    // once against a missing value, using the same comparison semantics as uncompiled
+    // evaluation.
+    Node property(const Filter& filter, const std::string& key) {
+        auto test = [&] (optional<Value> value) {
+            return filter(FeatureType::Unknown, {}, [&] (const std::string&) { return value; });
+        };
+
+        Node node;
+        node.missing = test({});
+
+        optional<uint32_t> keyIndex = layer.getKeyIndex(key);
+        if (!keyIndex) {
+            // No feature in this layer has the key.
+            node.kind = Node::Kind::Constant;
+            return node;
+        }
+
+        node.kind = Node::Kind::Property;
+        node.key = *keyIndex;
+        node.matches.reserve(values->size());
+        for (const Value& value : *values) {
+            node.matches.push_back(test(value));
+        }
+        return node;
+    }
+
+    Node type(const Filter& filter) {
+        auto test = [&] (FeatureType featureType) {
+            return filter(featureType, {}, [] (const std::string&) { return optional<Value>(); });
+        };
+
+        Node node;
+        node.kind = Node::Kind::Type;
+        for (uint8_t i = 0; i <= uint8_t(FeatureType::Polygon); i++) {
+            if (test(FeatureType(i))) {
+                node.types |= 1 << i;
+            }
+        }
+        node.otherTypes = test(FeatureType(uint8_t(FeatureType::Polygon) + 1));
+        return node;
+    }
+
+    Node combination(Node::Kind kind, const std::vector<Filter>& filters) {
+        Node node;
+        node.kind = kind;
+        node.operands.reserve(filters.size());
+        for (const Filter& filter : filters) {
+            node.operands.push_back(compile(filter));
+        }
+        return node;
+    }
+};
+
+CompiledFilter::CompiledFilter(const Filter& filter, const GeometryTileLayer& layer) {
+    Compiler { nodes, layer, layer.getValueTable() }.compile(filter);
+}
+
+bool CompiledFilter::operator()(const GeometryTileFeature& feature) const {
+    return evaluate(nodes.back(), feature);
+}
+
+bool CompiledFilter::evaluate(const Node& node, const GeometryTileFeature& feature) const {
+    switch (node.kind) {
+    case Node::Kind::Generic:
+        return (*node.filter)(feature);
+
+    case Node::Kind::Constant:
+        return node.missing;
+
+    case Node::Kind::Property: {
+        optional<uint32_t> value = feature.getValueIndex(node.key);
+        return value ? node.matches[*value] : node.missing;
+    }
+
+    case Node::Kind::Type: {
+        auto type = uint8_t(feature.getType());
+        return type <= uint8_t(FeatureType::Polygon) ? bool(node.types & (1 << type)) : node.otherTypes;
+    }
+
+    case Node::Kind::Any:
+        for (std::size_t operand : node.operands) {
+            if (evaluate(nodes[operand], feature)) {
+                return true;
+            }
+        }
+        return false;
+
+    case Node::Kind::All:
+        for (std::size_t operand : node.operands) {
+            if (!evaluate(nodes[operand], feature)) {
+                return false;
+            }
+        }
+        return true;
+
+    case Node::Kind::None:
+        for (std::size_t operand : node.operands) {
+            if (evaluate(nodes[operand], feature)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    return false;
+}
+
+} // namespace style
+} // namespace mbgl
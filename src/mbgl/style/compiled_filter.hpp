@@ -0,0 +1,67 @@
+#pragma once
+
+#include <mbgl/style/filter.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace mbgl {
+
+class GeometryTileFeature;
+class GeometryTileLayer;
+
+namespace style {
+
+/*
+   A `Filter` specialized for the features of one `GeometryTileLayer`.
+
+   For layers with shared key and value tables (see `GeometryTileLayer::getValueTable`),
+   property keys are resolved to key indices once, and each property comparison,
+   including `in` and `!in`, is precomputed into a bitset over the layer's value table.
+   Evaluating a feature then only scans its tags for the key index, without hashing
+   strings or copying values. Type comparisons become bitmask tests. Other clauses,
+   and all clauses for layers without value tables, fall back to `Filter::operator()`.
+
+   A compiled filter refers to the filter it was compiled from, which must outlive it.
+*/
+class CompiledFilter {
+public:
+    CompiledFilter(const Filter&, const GeometryTileLayer&);
+
+    bool operator()(const GeometryTileFeature&) const;
+
+private:
+    class Compiler;
+
+    struct Node {
+        enum class Kind : uint8_t { Generic, Constant, Property, Type, Any, All, None };
+
+        Kind kind = Kind::Generic;
+
+        // Generic: the clause to evaluate directly.
+        const Filter* filter = nullptr;
+
+        // Constant: the result for every feature. Property: the result for a
+        // feature without a value for the key.
+        bool missing = false;
+
+        // Property: the key index, and the result for each value table index.
+        uint32_t key = 0;
+        std::vector<bool> matches;
+
+        // Type: the result for each FeatureType, as a bitmask, and for
+        // out-of-range types.
+        uint8_t types = 0;
+        bool otherTypes = false;
+
+        // Any, All, None: the operand nodes.
+        std::vector<std::size_t> operands;
+    };
+
+    bool evaluate(const Node&, const GeometryTileFeature&) const;
+
+    std::vector<Node> nodes;
+};
+
+} // namespace style
+} // namespace mbgl
@@ -1,9 +1,8 @@
 #include <mbgl/style/conversion/geojson.hpp>
 
-#include <mbgl/util/rapidjson.hpp>
+#include <mbgl/util/geojson_reader.hpp>
 
 #include <string>
-#include <sstream>
 
 namespace mbgl {
 namespace style {
@@ -11,23 +10,12 @@ namespace conversion {
 
 template <>
 optional<GeoJSON> convertGeoJSON(const std::string& string, Error& error) {
-    rapidjson::GenericDocument<rapidjson::UTF8<>, rapidjson::CrtAllocator> d;
-    d.Parse(string.c_str());
-
-    if (d.HasParseError()) {
-        std::stringstream message;
-        message << d.GetErrorOffset() << " - " << rapidjson::GetParseError_En(d.GetParseError());
-        error = { message.str() };
+    try {
+        return util::parseGeoJSON(string);
+    } catch (const std::exception& ex) {
+        error = { ex.what() };
         return {};
     }
-
-    optional<GeoJSON> geoJSON = conversion::convertGeoJSON<JSValue>(d, error);
-    if (!geoJSON) {
-        error = { error.message };
-        return {};
-    }
-
-    return geoJSON;
 }
 
 } // namespace conversion
@@ -2,12 +2,16 @@
 
 #include <vector>
 #include <memory>
+#include <string>
 
 namespace mbgl {
 namespace style {
 
 class Layer;
 
+// Layers with the same key share a bucket.
+std::string layoutKey(const Layer&);
+
 std::vector<std::vector<const Layer*>> groupByLayout(const std::vector<std::unique_ptr<Layer>>&);
 
 } // namespace style
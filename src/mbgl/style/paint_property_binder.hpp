@@ -4,6 +4,7 @@
 #include <mbgl/gl/attribute.hpp>
 #include <mbgl/gl/uniform.hpp>
 #include <mbgl/util/type_list.hpp>
+#include <mbgl/map/memory_usage.hpp>
 
 namespace mbgl {
 namespace style {
@@ -59,6 +60,7 @@ public:
 
     virtual void populateVertexVector(const GeometryTileFeature& feature, std::size_t length) = 0;
     virtual void upload(gl::Context& context) = 0;
+    virtual MemoryUsage memoryUsage() const = 0;
     virtual AttributeBinding attributeBinding(const PossiblyEvaluatedPropertyValue<T>& currentValue) const = 0;
     virtual float interpolationFactor(float currentZoom) const = 0;
 
@@ -77,6 +79,7 @@ public:
 
     void populateVertexVector(const GeometryTileFeature&, std::size_t) override {}
     void upload(gl::Context&) override {}
+    MemoryUsage memoryUsage() const override { return {}; }
 
     AttributeBinding attributeBinding(const PossiblyEvaluatedPropertyValue<T>& currentValue) const override {
         auto value = attributeValue(currentValue.constantOr(constant));
@@ -119,6 +122,13 @@ public:
         vertexBuffer = context.createVertexBuffer(std::move(vertexVector));
     }
 
+    MemoryUsage memoryUsage() const override {
+        MemoryUsage result;
+        result.cpu = vertexVector.byteSize();
+        result.gpu = vertexBuffer ? vertexBuffer->byteSize() : 0;
+        return result;
+    }
+
     AttributeBinding attributeBinding(const PossiblyEvaluatedPropertyValue<T>& currentValue) const override {
         if (currentValue.isConstant()) {
             BaseAttributeValue value = attributeValue(*currentValue.constant());
@@ -172,6 +182,13 @@ public:
         vertexBuffer = context.createVertexBuffer(std::move(vertexVector));
     }
 
+    MemoryUsage memoryUsage() const override {
+        MemoryUsage result;
+        result.cpu = vertexVector.byteSize();
+        result.gpu = vertexBuffer ? vertexBuffer->byteSize() : 0;
+        return result;
+    }
+
     AttributeBinding attributeBinding(const PossiblyEvaluatedPropertyValue<T>& currentValue) const override {
         if (currentValue.isConstant()) {
             BaseAttributeValue value = attributeValue(*currentValue.constant());
@@ -260,6 +277,14 @@ public:
         });
     }
 
+    MemoryUsage memoryUsage() const {
+        MemoryUsage result;
+        util::ignore({
+            (result += binders.template get<Ps>()->memoryUsage(), 0)...
+        });
+        return result;
+    }
+
     template <class P>
     using Attribute = ZoomInterpolatedAttribute<typename P::Attribute>;
 
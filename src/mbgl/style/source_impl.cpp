@@ -1,5 +1,6 @@
 #include <mbgl/style/source_impl.hpp>
 #include <mbgl/style/source_observer.hpp>
+#include <mbgl/style/layer.hpp>
 #include <mbgl/map/transform.hpp>
 #include <mbgl/renderer/render_tile.hpp>
 #include <mbgl/renderer/painter.hpp>
@@ -10,6 +11,7 @@
 #include <mbgl/util/tile_cover.hpp>
 #include <mbgl/util/enum.hpp>
 #include <mbgl/map/query.hpp>
+#include <mbgl/map/memory_usage.hpp>
 #include <mbgl/style/query.hpp>
 
 #include <mbgl/algorithm/update_renderables.hpp>
@@ -48,6 +50,7 @@ bool Source::Impl::isLoaded() const {
     
 void Source::Impl::detach() {
     invalidateTiles();
+    setCacheBudget(0);
 }
 
 void Source::Impl::invalidateTiles() {
@@ -93,21 +96,27 @@ void Source::Impl::updateTiles(const UpdateParameters& parameters) {
     const uint16_t tileSize = getTileSize();
     const optional<Range<uint8_t>> zoomRange = getZoomRange();
 
-    // Determine the overzooming/underzooming amounts and required tiles.
-    int32_t overscaledZoom = util::coveringZoomLevel(parameters.transformState.getZoom(), type, tileSize);
-    int32_t tileZoom = overscaledZoom;
+    // Determine the overzooming/underzooming amounts and the tiles that cover `state`.
+    auto coverTiles = [&] (const TransformState& state, int32_t& tileZoom) {
+        int32_t overscaledZoom = util::coveringZoomLevel(state.getZoom(), type, tileSize);
+        tileZoom = overscaledZoom;
 
-    std::vector<UnwrappedTileID> idealTiles;
-    if (overscaledZoom >= zoomRange->min) {
-        int32_t idealZoom = std::min<int32_t>(zoomRange->max, overscaledZoom);
+        std::vector<UnwrappedTileID> result;
+        if (overscaledZoom >= zoomRange->min) {
+            int32_t idealZoom = std::min<int32_t>(zoomRange->max, overscaledZoom);
 
-        // Make sure we're not reparsing overzoomed raster tiles.
-        if (type == SourceType::Raster) {
-            tileZoom = idealZoom;
+            // Make sure we're not reparsing overzoomed raster tiles.
+            if (type == SourceType::Raster) {
+                tileZoom = idealZoom;
+            }
+
+            result = util::tileCover(state, idealZoom);
         }
+        return result;
+    };
 
-        idealTiles = util::tileCover(parameters.transformState, idealZoom);
-    }
+    int32_t tileZoom = 0;
+    const std::vector<UnwrappedTileID> idealTiles = coverTiles(parameters.transformState, tileZoom);
 
     // Stores a list of all the tiles that we're definitely going to retain. There are two
     // kinds of tiles we need: the ideal tiles determined by the tile cover. They may not yet be in
@@ -115,9 +124,34 @@ void Source::Impl::updateTiles(const UpdateParameters& parameters) {
     // we're actively using, e.g. as a replacement for tile that aren't loaded yet.
     std::set<OverscaledTileID> retain;
 
-    auto retainTileFn = [&retain](Tile& tile, Resource::Necessity necessity) -> void {
+    // The tiles that the camera is about to show, destination first, unless they are in view
+    // already. They may also serve as a fallback for the tiles in view, in which case they keep
+    // loading as prefetched tiles rather than being lowered to optional, which would cancel
+    // their requests only to send them again below.
+    std::vector<OverscaledTileID> prefetchTiles;
+    std::set<OverscaledTileID> prefetchSet;
+    if (type != SourceType::Annotations && !parameters.prefetchStates.empty()) {
+        std::set<OverscaledTileID> inView;
+        for (const auto& tileID : idealTiles) {
+            inView.emplace(tileZoom, tileID.canonical);
+        }
+
+        for (auto it = parameters.prefetchStates.rbegin(); it != parameters.prefetchStates.rend(); ++it) {
+            int32_t prefetchZoom = 0;
+            for (const auto& tileID : coverTiles(*it, prefetchZoom)) {
+                const OverscaledTileID dataTileID(prefetchZoom, tileID.canonical);
+                if (!inView.count(dataTileID) && prefetchSet.insert(dataTileID).second) {
+                    prefetchTiles.push_back(dataTileID);
+                }
+            }
+        }
+    }
+
+    auto retainTileFn = [&retain, &prefetchSet](Tile& tile, Resource::Necessity necessity) -> void {
         retain.emplace(tile.id);
-        tile.setNecessity(necessity);
+        if (necessity == Resource::Required || !prefetchSet.count(tile.id)) {
+            tile.setNecessity(necessity);
+        }
     };
     auto getTileFn = [this](const OverscaledTileID& tileID) -> Tile* {
         auto it = tiles.find(tileID);
@@ -144,13 +178,26 @@ void Source::Impl::updateTiles(const UpdateParameters& parameters) {
     algorithm::updateRenderables(getTileFn, createTileFn, retainTileFn, renderTileFn,
                                  idealTiles, *zoomRange, tileZoom);
 
-    if (type != SourceType::Annotations) {
+    // Prefetched tiles are only retained while the animation runs; when it ends or is
+    // interrupted, those that have not loaded are dropped, which cancels their requests.
+    for (const auto& dataTileID : prefetchTiles) {
+        Tile* tile = getTileFn(dataTileID);
+        if (!tile) {
+            tile = createTileFn(dataTileID);
+        }
+        if (tile) {
+            retain.emplace(dataTileID);
+            tile->prefetch();
+        }
+    }
+
+    if (type != SourceType::Annotations && !fixedCacheBudget) {
         size_t conservativeCacheSize =
             std::max((float)parameters.transformState.getSize().width / tileSize, 1.0f) *
             std::max((float)parameters.transformState.getSize().height / tileSize, 1.0f) *
             (parameters.transformState.getMaxZoom() - parameters.transformState.getMinZoom() + 1) *
             0.5;
-        cache.setSize(conservativeCacheSize);
+        cache.setMaxBytes(conservativeCacheSize * averageTileBytes());
     }
 
     removeStaleTiles(retain);
@@ -197,11 +244,11 @@ void Source::Impl::updateSymbolDependentTiles() {
     }
 }
 
-void Source::Impl::reloadTiles() {
+void Source::Impl::reloadTiles(const std::unordered_set<std::string>& changedLayerIDs) {
     cache.clear();
 
     for (auto& pair : tiles) {
-        pair.second->redoLayout();
+        pair.second->redoLayout(changedLayerIDs);
     }
 }
 
@@ -277,13 +324,67 @@ std::vector<Feature> Source::Impl::querySourceFeatures(const SourceQueryOptions&
 }
 
 void Source::Impl::setCacheSize(size_t size) {
-    cache.setSize(size);
+    if (type != SourceType::Annotations && !fixedCacheBudget) {
+        cache.setMaxBytes(size * averageTileBytes());
+    }
+}
+
+void Source::Impl::setCacheBudget(std::size_t maxBytes) {
+    if (type == SourceType::Annotations) {
+        return;
+    }
+
+    fixedCacheBudget = maxBytes > 0;
+    cache.setBudget(nullptr);
+    if (fixedCacheBudget) {
+        cache.setMaxBytes(maxBytes);
+    }
+}
+
+void Source::Impl::setCacheBudget(std::shared_ptr<TileCache::Budget> budget) {
+    if (type == SourceType::Annotations) {
+        return;
+    }
+
+    fixedCacheBudget = bool(budget);
+    cache.setBudget(std::move(budget));
+}
+
+std::size_t Source::Impl::averageTileBytes() const {
+    std::size_t bytes = cache.getBytes();
+    for (const auto& pair : tiles) {
+        bytes += TileCache::tileBytes(*pair.second);
+    }
+
+    // Without loaded tiles, budget for empty ones rather than for none at all.
+    const std::size_t count = cache.size() + tiles.size();
+    return std::max(count ? bytes / count : 0, TileCache::tileOverhead());
 }
 
 void Source::Impl::onLowMemory() {
     cache.clear();
 }
 
+void Source::Impl::addMemoryUsage(MapMemoryUsage& usage, const std::vector<const Layer*>& layers) const {
+    MemoryUsage& sourceUsage = usage.sources[id];
+
+    auto addTile = [&] (Tile& tile) {
+        sourceUsage += tile.memoryUsage();
+        for (const Layer* layer : layers) {
+            if (const Bucket* bucket = tile.getBucket(*layer)) {
+                usage.layers[layer->getID()] += bucket->memoryUsage();
+            }
+        }
+    };
+
+    for (const auto& pair : tiles) {
+        addTile(*pair.second);
+    }
+    cache.forEach(addTile);
+
+    usage.total += sourceUsage;
+}
+
 void Source::Impl::setObserver(SourceObserver* observer_) {
     observer = observer_;
 }
@@ -26,6 +26,7 @@ class FileSource;
 class TransformState;
 class RenderTile;
 class RenderedQueryOptions;
+class MapMemoryUsage;
 
 namespace algorithm {
 class ClipIDGenerator;
@@ -35,6 +36,7 @@ namespace style {
 
 class UpdateParameters;
 class SourceObserver;
+class Layer;
 
 class Source::Impl : public TileObserver, private util::noncopyable {
 public:
@@ -46,7 +48,7 @@ public:
 
     // Called when the camera has changed. May load new tiles, unload obsolete tiles, or
     // trigger re-placement of existing complete tiles.
-    void updateTiles(const UpdateParameters&);
+    virtual void updateTiles(const UpdateParameters&);
 
     // Called when icons or glyphs are loaded. Triggers further processing of tiles which
     // were waiting on such dependencies.
@@ -57,7 +59,7 @@ public:
 
     // Request that all loaded tiles re-run the layout operation on the existing source
     // data with fresh style information.
-    void reloadTiles();
+    void reloadTiles(const std::unordered_set<std::string>& changedLayerIDs);
 
     void startRender(algorithm::ClipIDGenerator&,
                      const mat4& projMatrix,
@@ -74,8 +76,18 @@ public:
     std::vector<Feature> querySourceFeatures(const SourceQueryOptions&);
 
     void setCacheSize(size_t);
+
+    // Limits the tile cache to `maxBytes`, or to a budget shared with other sources. Without
+    // a limit, the cache holds about as many tiles as the visible zoom range needs.
+    void setCacheBudget(std::size_t maxBytes);
+    void setCacheBudget(std::shared_ptr<TileCache::Budget>);
+
     void onLowMemory();
 
+    // Adds the memory used by the tiles of this source, in use or cached, to `usage`, and
+    // that used by the buckets of `layers` to their entries.
+    void addMemoryUsage(MapMemoryUsage& usage, const std::vector<const Layer*>& layers) const;
+
     void setObserver(SourceObserver*);
     void dumpDebugLogs() const;
 
@@ -103,12 +115,17 @@ protected:
     SourceObserver* observer = nullptr;
     std::map<OverscaledTileID, std::unique_ptr<Tile>> tiles;
     TileCache cache;
+    bool fixedCacheBudget = false;
 
 private:
     // TileObserver implementation.
     void onTileChanged(Tile&) override;
     void onTileError(Tile&, std::exception_ptr) override;
 
+    // The average memory the tiles of this source, in use or cached, are charged to the cache
+    // budget, and at least that of an empty tile.
+    std::size_t averageTileBytes() const;
+
     virtual uint16_t getTileSize() const = 0;
     virtual std::unique_ptr<Tile> createTile(const OverscaledTileID&, const UpdateParameters&) = 0;
 
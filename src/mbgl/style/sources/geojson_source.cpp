@@ -18,6 +18,14 @@ void GeoJSONSource::setGeoJSON(const mapbox::geojson::geojson& geoJSON) {
     impl->setGeoJSON(geoJSON);
 }
 
+void GeoJSONSource::setGeobuf(std::string data) {
+    impl->setGeobuf(std::move(data));
+}
+
+void GeoJSONSource::updateGeoJSON(const GeoJSONSourceDiff& diff) {
+    impl->updateGeoJSON(diff);
+}
+
 optional<std::string> GeoJSONSource::getURL() const {
     return impl->getURL();
 }
@@ -1,21 +1,17 @@
-#include <mbgl/util/logging.hpp>
 #include <mbgl/storage/file_source.hpp>
 #include <mbgl/style/conversion/geojson.hpp>
 #include <mbgl/style/source_observer.hpp>
 #include <mbgl/style/sources/geojson_source_impl.hpp>
+#include <mbgl/style/update_parameters.hpp>
 #include <mbgl/tile/geojson_tile.hpp>
 #include <mbgl/util/rapidjson.hpp>
+#include <mbgl/util/run_loop.hpp>
 
 #include <mapbox/geojson.hpp>
 #include <mapbox/geojson/rapidjson.hpp>
 #include <mapbox/geojsonvt.hpp>
-#include <mapbox/geojsonvt/convert.hpp>
 #include <supercluster.hpp>
 
-#include <rapidjson/error/en.h>
-
-#include <sstream>
-
 namespace mbgl {
 namespace style {
 namespace conversion {
@@ -58,39 +54,166 @@ void GeoJSONSource::Impl::setGeoJSON(const GeoJSON& geoJSON) {
     _setGeoJSON(geoJSON);
 }
 
+void GeoJSONSource::Impl::setGeobuf(std::string data) {
+    req.reset();
+    _setGeoJSON(std::make_shared<const std::string>(std::move(data)));
+}
+
+void GeoJSONSource::Impl::updateGeoJSON(const GeoJSONSourceDiff& diff) {
+    ++latestBuild;
+
+    if (worker) {
+        worker->invoke(&GeoJSONSourceWorker::updateGeoJSON, diff, latestBuild.load());
+    } else {
+        pendingDiffs.push_back(diff);
+    }
+}
+
 // Private implementation
-void GeoJSONSource::Impl::_setGeoJSON(const GeoJSON& geoJSON) {
-    double scale = util::EXTENT / util::tileSize;
-
-    cache.clear();
-
-    if (options.cluster
-        && geoJSON.is<mapbox::geometry::feature_collection<double>>()
-        && !geoJSON.get<mapbox::geometry::feature_collection<double>>().empty()) {
-        mapbox::supercluster::Options clusterOptions;
-        clusterOptions.maxZoom = options.clusterMaxZoom;
-        clusterOptions.extent = util::EXTENT;
-        clusterOptions.radius = std::round(scale * options.clusterRadius);
-
-        const auto& features = geoJSON.get<mapbox::geometry::feature_collection<double>>();
-        geoJSONOrSupercluster =
-            std::make_unique<mapbox::supercluster::Supercluster>(features, clusterOptions);
+void GeoJSONSource::Impl::_setGeoJSON(GeoJSON geoJSON) {
+    ++latestBuild;
+
+    if (worker) {
+        worker->invoke(&GeoJSONSourceWorker::setGeoJSON, std::move(geoJSON), latestBuild.load());
+    } else {
+        pendingGeoJSON = std::move(geoJSON);
+        pendingData.reset();
+        pendingDiffs.clear();
+    }
+}
+
+// GeoJSON text and Geobuf are decoded on the worker.
+void GeoJSONSource::Impl::_setGeoJSON(std::shared_ptr<const std::string> data) {
+    ++latestBuild;
+
+    if (worker) {
+        worker->invoke(&GeoJSONSourceWorker::parseGeoJSON, std::move(data), latestBuild.load());
+    } else {
+        pendingData = std::move(data);
+        pendingGeoJSON = {};
+        pendingDiffs.clear();
+    }
+}
+
+void GeoJSONSource::Impl::startWorker(Scheduler& scheduler) {
+    mailbox = std::make_shared<Mailbox>(*util::RunLoop::Get());
+    worker = std::make_unique<Actor<GeoJSONSourceWorker>>(scheduler,
+                                                          ActorRef<Impl>(*this, mailbox),
+                                                          options,
+                                                          latestBuild);
+
+    // Only the last of the pending changes needs to build an index; build ID 0 is never
+    // the latest one.
+    if (pendingGeoJSON) {
+        worker->invoke(&GeoJSONSourceWorker::setGeoJSON, std::move(*pendingGeoJSON),
+                       pendingDiffs.empty() ? latestBuild.load() : 0);
+        pendingGeoJSON = {};
+    } else if (pendingData) {
+        worker->invoke(&GeoJSONSourceWorker::parseGeoJSON, std::move(pendingData),
+                       pendingDiffs.empty() ? latestBuild.load() : 0);
+    }
+
+    for (std::size_t i = 0; i < pendingDiffs.size(); ++i) {
+        worker->invoke(&GeoJSONSourceWorker::updateGeoJSON, std::move(pendingDiffs[i]),
+                       i + 1 == pendingDiffs.size() ? latestBuild.load() : 0);
+    }
+    pendingDiffs.clear();
+}
+
+void GeoJSONSource::Impl::updateTiles(const UpdateParameters& parameters) {
+    if (!worker) {
+        startWorker(parameters.workerScheduler);
+    }
+
+    Source::Impl::updateTiles(parameters);
+}
+
+// Whether any of `regions` overlaps the tile, including its buffer, or one of its copies
+// across the antimeridian.
+static bool intersects(const CanonicalTileID& tileID,
+                       uint16_t buffer,
+                       const std::vector<GeoJSONSourceWorker::Region>& regions) {
+    const double size = 1.0 / (1u << tileID.z);
+    const double padding = size * buffer / util::tileSize;
+    const double minX = tileID.x * size - padding;
+    const double maxX = (tileID.x + 1) * size + padding;
+    const double minY = tileID.y * size - padding;
+    const double maxY = (tileID.y + 1) * size + padding;
+
+    for (const auto& region : regions) {
+        if (region.min.y > maxY || region.max.y < minY) {
+            continue;
+        }
+        for (const double shift : { -1.0, 0.0, 1.0 }) {
+            if (region.min.x + shift <= maxX && region.max.x + shift >= minX) {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+void GeoJSONSource::Impl::onIndex(Index index,
+                                  optional<std::vector<GeoJSONSourceWorker::Region>> regions,
+                                  uint64_t buildID) {
+    if (regions) {
+        changedRegions.insert(changedRegions.end(), regions->begin(), regions->end());
     } else {
-        mapbox::geojsonvt::Options vtOptions;
-        vtOptions.maxZoom = options.maxzoom;
-        vtOptions.extent = util::EXTENT;
-        vtOptions.buffer = std::round(scale * options.buffer);
-        vtOptions.tolerance = scale * options.tolerance;
-        geoJSONOrSupercluster = std::make_unique<mapbox::geojsonvt::GeoJSONVT>(geoJSON, vtOptions);
+        allTilesChanged = true;
     }
 
+    if (buildID != latestBuild) {
+        return; // Superseded by a newer build.
+    }
+
+    geoJSONOrSupercluster = std::move(index);
+    indexedBuild = buildID;
+
+    auto changed = [&] (const OverscaledTileID& tileID) {
+        return allTilesChanged || intersects(tileID.canonical, options.buffer, changedRegions);
+    };
+
+    cache.removeIf(changed);
+
     for (auto const &item : tiles) {
-        GeoJSONTile* geoJSONTile = static_cast<GeoJSONTile*>(item.second.get());
-        setTileData(*geoJSONTile, geoJSONTile->id);
+        if (changed(item.first)) {
+            GeoJSONTile* geoJSONTile = static_cast<GeoJSONTile*>(item.second.get());
+            setTileData(*geoJSONTile, geoJSONTile->id);
+        }
+    }
+
+    allTilesChanged = false;
+    changedRegions.clear();
+
+    if (!loaded) {
+        loaded = true;
+        observer->onSourceLoaded(base);
+    }
+}
+
+void GeoJSONSource::Impl::onIndexError(std::exception_ptr error, uint64_t buildID) {
+    if (buildID != latestBuild) {
+        return; // Superseded by a newer build.
+    }
+
+    observer->onSourceError(base, error);
+
+    if (!indexedBuild) {
+        // Create an empty GeoJSON VT object to make sure we're not infinitely waiting for
+        // tiles to load.
+        _setGeoJSON(GeoJSON{ FeatureCollection{} });
     }
 }
 
 void GeoJSONSource::Impl::setTileData(GeoJSONTile& tile, const OverscaledTileID& tileID) {
+    if (!indexedBuild) {
+        if (!latestBuild) {
+            tile.updateData({}); // The source has no data.
+        }
+        return; // The tile is updated once the index is built.
+    }
+
     if (geoJSONOrSupercluster.is<GeoJSONVTPointer>()) {
         tile.updateData(geoJSONOrSupercluster.get<GeoJSONVTPointer>()->getTile(tileID.canonical.z,
                                                                                tileID.canonical.x,
@@ -123,34 +246,10 @@ void GeoJSONSource::Impl::loadDescription(FileSource& fileSource) {
             observer->onSourceError(
                 base, std::make_exception_ptr(std::runtime_error("unexpectedly empty GeoJSON")));
         } else {
-            rapidjson::GenericDocument<rapidjson::UTF8<>, rapidjson::CrtAllocator> d;
-            d.Parse<0>(res.data->c_str());
-
-            if (d.HasParseError()) {
-                std::stringstream message;
-                message << d.GetErrorOffset() << " - "
-                        << rapidjson::GetParseError_En(d.GetParseError());
-                observer->onSourceError(base,
-                                        std::make_exception_ptr(std::runtime_error(message.str())));
-                return;
-            }
-
-            invalidateTiles();
-
-            conversion::Error error;
-            optional<GeoJSON> geoJSON = conversion::convertGeoJSON<JSValue>(d, error);
-            if (!geoJSON) {
-                Log::Error(Event::ParseStyle, "Failed to parse GeoJSON data: %s",
-                           error.message.c_str());
-                // Create an empty GeoJSON VT object to make sure we're not infinitely waiting for
-                // tiles to load.
-                _setGeoJSON(GeoJSON{ FeatureCollection{} });
-            } else {
-                _setGeoJSON(*geoJSON);
-            }
+            // Either GeoJSON text, which is parsed with a streaming reader, or Geobuf.
+            _setGeoJSON(res.data);
 
-            loaded = true;
-            observer->onSourceLoaded(base);
+            // The source is loaded once the index is built, in `onIndex`.
         }
     });
 }
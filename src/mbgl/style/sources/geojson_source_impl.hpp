@@ -2,9 +2,14 @@
 
 #include <mbgl/style/source_impl.hpp>
 #include <mbgl/style/sources/geojson_source.hpp>
+#include <mbgl/style/sources/geojson_source_worker.hpp>
+#include <mbgl/actor/actor.hpp>
+#include <mbgl/actor/mailbox.hpp>
 #include <mbgl/util/variant.hpp>
 #include <mbgl/tile/geojson_tile.hpp>
 
+#include <atomic>
+
 namespace mbgl {
 
 class AsyncRequest;
@@ -13,6 +18,8 @@ namespace style {
 
 class GeoJSONSource::Impl : public Source::Impl {
 public:
+    using Index = variant<GeoJSONVTPointer, SuperclusterPointer>;
+
     Impl(std::string id, Source&, const GeoJSONOptions);
     ~Impl() final;
 
@@ -20,9 +27,12 @@ public:
     optional<std::string> getURL() const;
 
     void setGeoJSON(const GeoJSON&);
+    void setGeobuf(std::string);
+    void updateGeoJSON(const GeoJSONSourceDiff&);
     void setTileData(GeoJSONTile&, const OverscaledTileID& tileID);
 
     void loadDescription(FileSource&) final;
+    void updateTiles(const UpdateParameters&) final;
 
     uint16_t getTileSize() const final {
         return util::tileSize;
@@ -30,15 +40,38 @@ public:
 
     optional<Range<uint8_t>> getZoomRange() const final;
 
+    // Messages from the worker.
+    void onIndex(Index, optional<std::vector<GeoJSONSourceWorker::Region>> changedRegions, uint64_t buildID);
+    void onIndexError(std::exception_ptr, uint64_t buildID);
+
 private:
-    void _setGeoJSON(const GeoJSON&);
+    void _setGeoJSON(GeoJSON);
+    void _setGeoJSON(std::shared_ptr<const std::string> data);
+    void startWorker(Scheduler&);
 
     std::unique_ptr<Tile> createTile(const OverscaledTileID&, const UpdateParameters&) final;
 
     GeoJSONOptions options;
     optional<std::string> url;
     std::unique_ptr<AsyncRequest> req;
-    variant<GeoJSONVTPointer, SuperclusterPointer> geoJSONOrSupercluster;
+
+    // The index is built on the worker scheduler; until a new build arrives, tiles keep
+    // using the previous one. `pendingGeoJSON` (or the undecoded `pendingData`) and
+    // `pendingDiffs` hold changes that are waiting for the first update, which provides
+    // the scheduler.
+    Index geoJSONOrSupercluster;
+    optional<GeoJSON> pendingGeoJSON;
+    std::shared_ptr<const std::string> pendingData;
+    std::vector<GeoJSONSourceDiff> pendingDiffs;
+    std::atomic<uint64_t> latestBuild { 0 };
+    uint64_t indexedBuild = 0;
+
+    // Changes that came with superseded builds, to be applied with the next index.
+    bool allTilesChanged = false;
+    std::vector<GeoJSONSourceWorker::Region> changedRegions;
+
+    std::shared_ptr<Mailbox> mailbox;
+    std::unique_ptr<Actor<GeoJSONSourceWorker>> worker;
 };
 
 } // namespace style
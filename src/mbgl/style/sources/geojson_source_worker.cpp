@@ -0,0 +1,180 @@
+#include <mbgl/style/sources/geojson_source_worker.hpp>
+#include <mbgl/style/sources/geojson_source_impl.hpp>
+#include <mbgl/util/constants.hpp>
+#include <mbgl/util/geobuf_reader.hpp>
+#include <mbgl/util/geojson_reader.hpp>
+#include <mbgl/math/clamp.hpp>
+
+#include <mapbox/geometry/envelope.hpp>
+#include <mapbox/geojsonvt.hpp>
+#include <supercluster.hpp>
+
+#include <cmath>
+#include <functional>
+
+namespace mbgl {
+namespace style {
+
+std::size_t GeoJSONSourceWorker::FeatureIdentifierHash::operator()(const FeatureIdentifier& id) const {
+    return FeatureIdentifier::visit(id, [] (const auto& value) {
+        return std::hash<std::decay_t<decltype(value)>>()(value);
+    });
+}
+
+GeoJSONSourceWorker::GeoJSONSourceWorker(ActorRef<GeoJSONSourceWorker>,
+                                         ActorRef<GeoJSONSource::Impl> parent_,
+                                         GeoJSONOptions options_,
+                                         const std::atomic<uint64_t>& latestBuild_)
+    : parent(std::move(parent_)),
+      options(std::move(options_)),
+      latestBuild(latestBuild_) {
+}
+
+void GeoJSONSourceWorker::setGeoJSON(GeoJSON geoJSON, uint64_t buildID) {
+    if (geoJSON.is<mapbox::geometry::feature_collection<double>>()) {
+        reset(std::move(geoJSON.get<mapbox::geometry::feature_collection<double>>()));
+    } else if (geoJSON.is<mapbox::geometry::feature<double>>()) {
+        reset({ std::move(geoJSON.get<mapbox::geometry::feature<double>>()) });
+    } else {
+        reset({ Feature { std::move(geoJSON.get<mapbox::geometry::geometry<double>>()) } });
+    }
+
+    build(buildID);
+}
+
+void GeoJSONSourceWorker::parseGeoJSON(std::shared_ptr<const std::string> data, uint64_t buildID) {
+    mapbox::geometry::feature_collection<double> parsed;
+
+    auto onFeature = [&] (Feature&& feature) {
+        parsed.push_back(std::move(feature));
+    };
+
+    try {
+        if (util::isGeobuf(*data)) {
+            util::parseGeobufFeatures(*data, onFeature);
+        } else {
+            util::parseGeoJSONFeatures(*data, onFeature);
+        }
+    } catch (...) {
+        // Keep the current data, as with any other failed change.
+        parent.invoke(&GeoJSONSource::Impl::onIndexError, std::current_exception(), buildID);
+        return;
+    }
+
+    data.reset();
+    reset(std::move(parsed));
+    build(buildID);
+}
+
+void GeoJSONSourceWorker::reset(mapbox::geometry::feature_collection<double> features_) {
+    features = std::move(features_);
+    featureIndices.clear();
+    changedRegions = {};
+
+    for (std::size_t i = 0; i < features.size(); ++i) {
+        if (features[i].id) {
+            featureIndices[*features[i].id] = i;
+        }
+    }
+}
+
+void GeoJSONSourceWorker::updateGeoJSON(GeoJSONSourceDiff diff, uint64_t buildID) {
+    for (const auto& id : diff.remove) {
+        auto it = featureIndices.find(id);
+        if (it != featureIndices.end()) {
+            remove(it->second);
+        }
+    }
+
+    for (auto& feature : diff.update) {
+        changed(feature.geometry);
+
+        auto it = feature.id ? featureIndices.find(*feature.id) : featureIndices.end();
+        if (it != featureIndices.end()) {
+            changed(features[it->second].geometry);
+            features[it->second] = std::move(feature);
+        } else {
+            if (feature.id) {
+                featureIndices.emplace(*feature.id, features.size());
+            }
+            features.push_back(std::move(feature));
+        }
+    }
+
+    build(buildID);
+}
+
+// Removes the feature at `index` by moving the last feature into its place.
+void GeoJSONSourceWorker::remove(std::size_t index) {
+    changed(features[index].geometry);
+    featureIndices.erase(*features[index].id);
+
+    if (index != features.size() - 1) {
+        features[index] = std::move(features.back());
+        if (features[index].id) {
+            featureIndices[*features[index].id] = index;
+        }
+    }
+
+    features.pop_back();
+}
+
+void GeoJSONSourceWorker::changed(const mapbox::geometry::geometry<double>& geometry) {
+    if (!changedRegions) {
+        return; // Everything has changed already.
+    }
+
+    if (options.cluster) {
+        // A cluster may move whenever one of its points does, so there's no telling
+        // which tiles are affected.
+        changedRegions = {};
+        return;
+    }
+
+    // Project the bounds of the geometry the way geojson-vt projects coordinates.
+    const auto bounds = mapbox::geometry::envelope(geometry);
+    auto project = [] (double lon, double lat) {
+        const double sine = std::sin(lat * util::DEG2RAD);
+        const double y = 0.5 - 0.25 * std::log((1 + sine) / (1 - sine)) / M_PI;
+        return mapbox::geometry::point<double> { lon / 360 + 0.5, util::clamp(y, 0.0, 1.0) };
+    };
+
+    changedRegions->push_back({ project(bounds.min.x, bounds.max.y),
+                                project(bounds.max.x, bounds.min.y) });
+}
+
+void GeoJSONSourceWorker::build(uint64_t buildID) {
+    if (buildID != latestBuild) {
+        return; // Superseded by a newer change, which will build the index.
+    }
+
+    try {
+        double scale = util::EXTENT / util::tileSize;
+
+        GeoJSONSource::Impl::Index index;
+        if (options.cluster && !features.empty()) {
+            mapbox::supercluster::Options clusterOptions;
+            clusterOptions.maxZoom = options.clusterMaxZoom;
+            clusterOptions.extent = util::EXTENT;
+            clusterOptions.radius = std::round(scale * options.clusterRadius);
+
+            index = std::make_unique<mapbox::supercluster::Supercluster>(features, clusterOptions);
+        } else {
+            mapbox::geojsonvt::Options vtOptions;
+            vtOptions.maxZoom = options.maxzoom;
+            vtOptions.extent = util::EXTENT;
+            vtOptions.buffer = std::round(scale * options.buffer);
+            vtOptions.tolerance = scale * options.tolerance;
+            index = std::make_unique<mapbox::geojsonvt::GeoJSONVT>(features, vtOptions);
+        }
+
+        parent.invoke(&GeoJSONSource::Impl::onIndex, std::move(index), std::move(changedRegions), buildID);
+        changedRegions = std::vector<Region>();
+    } catch (...) {
+        parent.invoke(&GeoJSONSource::Impl::onIndexError, std::current_exception(), buildID);
+        changedRegions = {}; // The next index replaces the data of all tiles.
+    }
+}
+
+} // namespace style
+} // namespace mbgl
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <mbgl/actor/actor_ref.hpp>
+#include <mbgl/style/sources/geojson_source.hpp>
+#include <mbgl/util/geojson.hpp>
+#include <mbgl/util/optional.hpp>
+
+#include <mapbox/geometry/box.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace mbgl {
+namespace style {
+
+/*
+   Holds the features of a GeoJSON source, and builds its tile index -- a geojson-vt or
+   supercluster index -- off the main thread.
+
+   GeoJSON text and Geobuf are decoded here too, adding each feature to the source's
+   feature store as it is read.
+
+   Each change to the data is numbered by the source. After applying a change, the index
+   is rebuilt and sent to the source along with the regions that changed since the last
+   index was sent, unless a newer change is already on its way.
+*/
+class GeoJSONSourceWorker {
+public:
+    // World coordinates, in [0, 1] from the north-west corner.
+    using Region = mapbox::geometry::box<double>;
+
+    GeoJSONSourceWorker(ActorRef<GeoJSONSourceWorker> self,
+                        ActorRef<GeoJSONSource::Impl> parent,
+                        GeoJSONOptions,
+                        const std::atomic<uint64_t>& latestBuild);
+
+    void setGeoJSON(GeoJSON, uint64_t buildID);
+    void updateGeoJSON(GeoJSONSourceDiff, uint64_t buildID);
+
+    // Reads features directly from GeoJSON text or Geobuf, without an intermediate JSON
+    // document.
+    void parseGeoJSON(std::shared_ptr<const std::string> data, uint64_t buildID);
+
+private:
+    void reset(mapbox::geometry::feature_collection<double>);
+    void build(uint64_t buildID);
+    void changed(const mapbox::geometry::geometry<double>&);
+    void remove(std::size_t index);
+
+    class FeatureIdentifierHash {
+    public:
+        std::size_t operator()(const FeatureIdentifier&) const;
+    };
+
+    ActorRef<GeoJSONSource::Impl> parent;
+    const GeoJSONOptions options;
+    const std::atomic<uint64_t>& latestBuild;
+
+    mapbox::geometry::feature_collection<double> features;
+    std::unordered_map<FeatureIdentifier, std::size_t, FeatureIdentifierHash> featureIndices;
+
+    // Regions changed since the last index was sent, or nothing if all of them have.
+    optional<std::vector<Region>> changedRegions;
+};
+
+} // namespace style
+} // namespace mbgl
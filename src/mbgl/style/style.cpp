@@ -32,6 +32,7 @@
 #include <mbgl/util/math.hpp>
 #include <mbgl/math/minmax.hpp>
 #include <mbgl/map/query.hpp>
+#include <mbgl/map/memory_usage.hpp>
 
 #include <algorithm>
 
@@ -152,6 +153,7 @@ void Style::addSource(std::unique_ptr<Source> source) {
     }
 
     source->baseImpl->setObserver(this);
+    setSourceCacheBudget(*source);
     sources.emplace_back(std::move(source));
 }
 
@@ -284,10 +286,11 @@ void Style::relayout() {
     for (const auto& sourceID : updateBatch.sourceIDs) {
         Source* source = getSource(sourceID);
         if (source && source->baseImpl->enabled) {
-            source->baseImpl->reloadTiles();
+            source->baseImpl->reloadTiles(updateBatch.layerIDs);
         }
     }
     updateBatch.sourceIDs.clear();
+    updateBatch.layerIDs.clear();
 }
 
 void Style::cascade(const TimePoint& timePoint, MapMode mode) {
@@ -563,12 +566,50 @@ void Style::setSourceTileCacheSize(size_t size) {
     }
 }
 
+void Style::setSourceTileCacheBytes(std::size_t bytes, bool shared) {
+    sourceCacheBytes = bytes;
+    sourceCacheBudget = shared && bytes ? std::make_shared<TileCache::Budget>(bytes) : nullptr;
+
+    for (const auto& source : sources) {
+        setSourceCacheBudget(*source);
+    }
+}
+
+void Style::setSourceCacheBudget(Source& source) {
+    if (sourceCacheBudget) {
+        source.baseImpl->setCacheBudget(sourceCacheBudget);
+    } else {
+        source.baseImpl->setCacheBudget(sourceCacheBytes);
+    }
+}
+
 void Style::onLowMemory() {
     for (const auto& source : sources) {
         source->baseImpl->onLowMemory();
     }
 }
 
+MapMemoryUsage Style::getMemoryUsage() const {
+    MapMemoryUsage result;
+
+    for (const auto& source : sources) {
+        std::vector<const Layer*> sourceLayers;
+        for (const auto& layer : layers) {
+            if (layer->baseImpl->source == source->getID()) {
+                sourceLayers.push_back(layer.get());
+            }
+        }
+        source->baseImpl->addMemoryUsage(result, sourceLayers);
+    }
+
+    result.glyphAtlas = glyphAtlas->memoryUsage();
+    result.spriteAtlas = spriteAtlas->memoryUsage();
+    result.lineAtlas = lineAtlas->memoryUsage();
+    result.total += result.glyphAtlas + result.spriteAtlas + result.lineAtlas;
+
+    return result;
+}
+
 void Style::setObserver(style::Observer* observer_) {
     observer = observer_;
 }
@@ -648,6 +689,7 @@ struct QueueSourceReloadVisitor {
     template <class VectorLayer>
     void operator()(VectorLayer& layer) {
         updateBatch.sourceIDs.insert(layer.getSourceID());
+        updateBatch.layerIDs.insert(layer.getID());
     }
 };
 
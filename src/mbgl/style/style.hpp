@@ -9,6 +9,7 @@
 #include <mbgl/sprite/sprite_atlas_observer.hpp>
 #include <mbgl/map/mode.hpp>
 #include <mbgl/map/zoom_history.hpp>
+#include <mbgl/tile/tile_cache.hpp>
 
 #include <mbgl/util/noncopyable.hpp>
 #include <mbgl/util/chrono.hpp>
@@ -30,6 +31,7 @@ class LineAtlas;
 class RenderData;
 class TransformState;
 class RenderedQueryOptions;
+class MapMemoryUsage;
 
 namespace style {
 
@@ -104,8 +106,11 @@ public:
     float getQueryRadius() const;
 
     void setSourceTileCacheSize(size_t);
+    void setSourceTileCacheBytes(std::size_t bytes, bool shared);
     void onLowMemory();
 
+    MapMemoryUsage getMemoryUsage() const;
+
     void dumpDebugLogs() const;
 
     FileSource& fileSource;
@@ -119,6 +124,10 @@ private:
     std::vector<std::string> classes;
     TransitionOptions transitionOptions;
 
+    // Tile cache limits for new sources; see Map::setSourceTileCacheBytes.
+    std::size_t sourceCacheBytes = 0;
+    std::shared_ptr<TileCache::Budget> sourceCacheBudget;
+
     // Defaults
     std::string name;
     LatLng defaultLatLng;
@@ -128,6 +137,7 @@ private:
 
     std::vector<std::unique_ptr<Layer>>::const_iterator findLayer(const std::string& layerID) const;
     void reloadLayerSource(Layer&);
+    void setSourceCacheBudget(Source&);
     void updateSymbolDependentTiles();
 
     // GlyphStoreObserver implementation.
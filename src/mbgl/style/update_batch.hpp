@@ -9,6 +9,9 @@ namespace style {
 class UpdateBatch {
 public:
     std::unordered_set<std::string> sourceIDs;
+
+    // Layers whose buckets must be rebuilt by the next layout of those sources.
+    std::unordered_set<std::string> layerIDs;
 };
 
 } // namespace style
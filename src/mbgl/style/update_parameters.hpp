@@ -1,10 +1,13 @@
 #pragma once
 
 #include <mbgl/map/mode.hpp>
+#include <mbgl/map/transform_state.hpp>
+
+#include <utility>
+#include <vector>
 
 namespace mbgl {
 
-class TransformState;
 class Scheduler;
 class FileSource;
 class AnnotationManager;
@@ -22,7 +25,8 @@ public:
                           FileSource& fileSource_,
                           const MapMode mode_,
                           AnnotationManager& annotationManager_,
-                          Style& style_)
+                          Style& style_,
+                          std::vector<TransformState> prefetchStates_ = {})
         : pixelRatio(pixelRatio_),
           debugOptions(debugOptions_),
           transformState(transformState_),
@@ -30,7 +34,8 @@ public:
           fileSource(fileSource_),
           mode(mode_),
           annotationManager(annotationManager_),
-          style(style_) {}
+          style(style_),
+          prefetchStates(std::move(prefetchStates_)) {}
 
     float pixelRatio;
     MapDebugOptions debugOptions;
@@ -42,6 +47,9 @@ public:
 
     // TODO: remove
     Style& style;
+
+    // Camera states for which sources load tiles ahead of time; see Transform::getPrefetchStates.
+    const std::vector<TransformState> prefetchStates;
 };
 
 } // namespace style
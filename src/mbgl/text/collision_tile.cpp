@@ -168,6 +168,10 @@ Box CollisionTile::getTreeBox(const Point<float>& anchor, const CollisionBox& bo
     };
 }
 
+std::size_t CollisionTile::bytes() const {
+    return sizeof(CollisionTile) + (tree.size() + ignoredTree.size()) * sizeof(CollisionTreeBox);
+}
+
 std::vector<IndexedSubfeature> CollisionTile::queryRenderedSymbols(const GeometryCoordinates& queryGeometry, float scale) const {
     std::vector<IndexedSubfeature> result;
     if (queryGeometry.empty() || (tree.empty() && ignoredTree.empty())) {
@@ -44,6 +44,10 @@ public:
 
     std::vector<IndexedSubfeature> queryRenderedSymbols(const GeometryCoordinates&, float scale) const;
 
+    // An estimate of the memory used by the collision trees, which is dominated by their
+    // values rather than by their nodes.
+    std::size_t bytes() const;
+
     const PlacementConfig config;
 
     const float minScale = 0.5f;
@@ -180,6 +180,21 @@ Size GlyphAtlas::getSize() const {
     return image.size;
 }
 
+MemoryUsage GlyphAtlas::memoryUsage() const {
+    MemoryUsage result;
+    result.cpu = image.bytes();
+    result.gpu = texture ? image.bytes() : 0;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const auto& entry : entries) {
+        for (const auto& pair : entry.second.glyphSet.getSDFs()) {
+            result.cpu += sizeof(SDFGlyph) + pair.second.bitmap.bytes();
+        }
+    }
+
+    return result;
+}
+
 void GlyphAtlas::upload(gl::Context& context, gl::TextureUnit unit) {
     if (!texture) {
         texture = context.createTexture(image, unit);
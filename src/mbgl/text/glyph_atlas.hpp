@@ -11,6 +11,7 @@
 #include <mbgl/util/image.hpp>
 #include <mbgl/gl/texture.hpp>
 #include <mbgl/gl/object.hpp>
+#include <mbgl/map/memory_usage.hpp>
 
 #include <atomic>
 #include <string>
@@ -68,6 +69,9 @@ public:
 
     Size getSize() const;
 
+    // The memory used by the atlas and by the glyphs it has loaded.
+    MemoryUsage memoryUsage() const;
+
 private:
     void requestGlyphRange(const FontStack&, const GlyphRange&);
 
@@ -92,7 +96,7 @@ private:
     };
 
     std::unordered_map<FontStack, Entry, FontStackHash> entries;
-    std::mutex mutex;
+    mutable std::mutex mutex;
 
     util::WorkQueue workQueue;
     GlyphAtlasObserver* observer = nullptr;
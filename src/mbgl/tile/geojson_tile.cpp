@@ -2,6 +2,7 @@
 #include <mbgl/tile/geometry_tile_data.hpp>
 #include <mbgl/style/query.hpp>
 
+#include <mapbox/geometry/for_each_point.hpp>
 #include <mapbox/geojsonvt.hpp>
 #include <supercluster.hpp>
 
@@ -57,6 +58,12 @@ public:
 
     GeoJSONTileData(mapbox::geometry::feature_collection<int16_t> features_)
         : features(std::move(features_)) {
+        std::size_t points = 0;
+        for (const auto& feature : features) {
+            mapbox::geometry::for_each_point(feature.geometry, [&] (const auto&) { ++points; });
+        }
+        featureBytes = features.size() * sizeof(mapbox::geometry::feature<int16_t>) +
+                       points * sizeof(mapbox::geometry::point<int16_t>);
     }
 
     std::unique_ptr<GeometryTileData> clone() const override {
@@ -67,6 +74,10 @@ public:
         return this;
     }
 
+    std::size_t bytes() const override {
+        return featureBytes;
+    }
+
     std::string getName() const override {
         return "";
     }
@@ -78,6 +89,17 @@ public:
     std::unique_ptr<GeometryTileFeature> getFeature(std::size_t i) const override {
         return std::make_unique<GeoJSONTileFeature>(features[i]);
     }
+
+    void eachFeature(const FeatureVisitor& visitor) const override {
+        for (std::size_t i = 0; i < features.size(); i++) {
+            if (!visitor(i, GeoJSONTileFeature(features[i]))) {
+                return;
+            }
+        }
+    }
+
+private:
+    std::size_t featureBytes;
 };
 
 GeoJSONTile::GeoJSONTile(const OverscaledTileID& overscaledTileID,
@@ -90,8 +112,6 @@ void GeoJSONTile::updateData(const mapbox::geometry::feature_collection<int16_t>
     setData(std::make_unique<GeoJSONTileData>(features));
 }
 
-void GeoJSONTile::setNecessity(Necessity) {}
-    
 void GeoJSONTile::querySourceFeatures(
     std::vector<Feature>& result,
     const style::SourceQueryOptions& options) {
@@ -100,17 +120,13 @@ void GeoJSONTile::querySourceFeatures(
     auto layer = getData()->getLayer({});
     
     if (layer) {
-        auto featureCount = layer->featureCount();
-        for (std::size_t i = 0; i < featureCount; i++) {
-            auto feature = layer->getFeature(i);
-            
+        layer->eachFeature([&] (std::size_t, const GeometryTileFeature& feature) {
             // Apply filter, if any
-            if (options.filter && !(*options.filter)(*feature)) {
-                continue;
+            if (!options.filter || (*options.filter)(feature)) {
+                result.push_back(convertFeature(feature, id.canonical));
             }
-            
-            result.push_back(convertFeature(*feature, id.canonical));
-        }
+            return true;
+        });
     }
 }
 
@@ -0,0 +1,61 @@
+#include <mbgl/tile/geometry_cache.hpp>
+
+namespace mbgl {
+
+constexpr std::size_t GeometryCache::defaultMaxBytes;
+
+static std::size_t geometryBytes(const GeometryCollection& geometry) {
+    std::size_t bytes = geometry.capacity() * sizeof(GeometryCoordinates);
+    for (const auto& ring : geometry) {
+        bytes += ring.capacity() * sizeof(GeometryCoordinate);
+    }
+    return bytes;
+}
+
+GeometryCache::GeometryCache(std::size_t maxBytes_)
+    : maxBytes(maxBytes_) {
+}
+
+GeometryCache::LayerGeometries* GeometryCache::getLayer(const GeometryTileLayer& layer) {
+    auto it = layers.find(&layer);
+    if (it != layers.end()) {
+        return &it->second;
+    }
+
+    const std::size_t count = layer.featureCount();
+    const std::size_t bytes = count * sizeof(LayerGeometries::value_type);
+    if (usedBytes + bytes > maxBytes) {
+        return nullptr;
+    }
+
+    usedBytes += bytes;
+    return &layers.emplace(&layer, LayerGeometries(count)).first->second;
+}
+
+const GeometryCollection& GeometryCache::getGeometries(const GeometryTileLayer& layer,
+                                                       std::size_t index,
+                                                       const GeometryTileFeature& feature) {
+    LayerGeometries* geometries = getLayer(layer);
+    if (geometries && index < geometries->size()) {
+        optional<GeometryCollection>& cached = (*geometries)[index];
+        if (cached) {
+            return *cached;
+        }
+
+        GeometryCollection geometry = feature.getGeometries();
+        const std::size_t bytes = geometryBytes(geometry);
+        if (usedBytes + bytes <= maxBytes) {
+            usedBytes += bytes;
+            cached = std::move(geometry);
+            return *cached;
+        }
+
+        uncached = std::move(geometry);
+        return uncached;
+    }
+
+    uncached = feature.getGeometries();
+    return uncached;
+}
+
+} // namespace mbgl
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <mbgl/tile/geometry_tile_data.hpp>
+#include <mbgl/util/optional.hpp>
+
+#include <unordered_map>
+#include <vector>
+
+namespace mbgl {
+
+/*
+   Memoizes decoded feature geometry for one layout pass of a tile, keyed by source
+   layer and feature index, so that layer groups reading the same source layer decode
+   each feature once and share the result with `FeatureIndex::insert`.
+
+   Once the cache holds `maxBytes` of geometry, further features are decoded on
+   demand and not retained.
+*/
+class GeometryCache {
+public:
+    static constexpr std::size_t defaultMaxBytes = 8 * 1024 * 1024;
+
+    explicit GeometryCache(std::size_t maxBytes = defaultMaxBytes);
+
+    // Returns the geometry of the feature at `index` in `layer`, decoding it from `feature`
+    // if it isn't cached. The reference is valid until the next call.
+    const GeometryCollection& getGeometries(const GeometryTileLayer& layer,
+                                            std::size_t index,
+                                            const GeometryTileFeature& feature);
+
+    std::size_t bytes() const { return usedBytes; }
+
+private:
+    using LayerGeometries = std::vector<optional<GeometryCollection>>;
+
+    LayerGeometries* getLayer(const GeometryTileLayer&);
+
+    const std::size_t maxBytes;
+    std::size_t usedBytes = 0;
+    std::unordered_map<const GeometryTileLayer*, LayerGeometries> layers;
+    GeometryCollection uncached;
+};
+
+} // namespace mbgl
@@ -0,0 +1,296 @@
+#include <mbgl/tile/geometry_decoder.hpp>
+#include <mbgl/util/constants.hpp>
+
+#include <array>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace mbgl {
+
+namespace {
+
+// Decodes one varint of up to ten bytes. Like protozero's packed uint32 fields,
+// bits beyond the 32nd are discarded.
+inline uint32_t decodeVarint(const uint8_t*& p, const uint8_t* end) {
+    uint64_t value = 0;
+    for (unsigned shift = 0; shift < 64; shift += 7) {
+        if (p == end) {
+            throw std::runtime_error("unterminated varint");
+        }
+        const uint8_t byte = *p++;
+        value |= uint64_t(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            return uint32_t(value);
+        }
+    }
+    throw std::runtime_error("varint too long");
+}
+
+inline int32_t decodeZigzag(uint32_t value) {
+    return int32_t(value >> 1) ^ -int32_t(value & 1);
+}
+
+// Replaces `points` zigzag-encoded (dx, dy) pairs with absolute coordinates,
+// starting from and updating the running position (x, y).
+inline void decodeDeltas(uint32_t* values, std::size_t points, int32_t& x, int32_t& y) {
+    int32_t* coordinates = reinterpret_cast<int32_t*>(values);
+    std::size_t k = 0;
+
+#if defined(__SSE2__)
+    const __m128i one = _mm_set1_epi32(1);
+    __m128i position = _mm_set_epi32(y, x, y, x);
+    for (; k + 2 <= points; k += 2) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + 2 * k));
+        v = _mm_xor_si128(_mm_srli_epi32(v, 1), _mm_sub_epi32(_mm_setzero_si128(), _mm_and_si128(v, one)));
+        // Prefix sum over the two pairs, then offset by the running position.
+        v = _mm_add_epi32(v, _mm_slli_si128(v, 8));
+        v = _mm_add_epi32(v, position);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(coordinates + 2 * k), v);
+        position = _mm_shuffle_epi32(v, _MM_SHUFFLE(3, 2, 3, 2));
+    }
+    x = _mm_cvtsi128_si32(position);
+    y = _mm_cvtsi128_si32(_mm_shuffle_epi32(position, _MM_SHUFFLE(1, 1, 1, 1)));
+#endif
+
+    for (; k < points; k++) {
+        x += decodeZigzag(values[2 * k]);
+        y += decodeZigzag(values[2 * k + 1]);
+        coordinates[2 * k] = x;
+        coordinates[2 * k + 1] = y;
+    }
+}
+
+// Walks the command stream with the same semantics the scalar decoder always had,
+// calling `moveTo(i)` for each MoveTo point, `lineTo(i, n)` for each run of n LineTo
+// points, and `closePath()` for each ClosePath, where i is the index of the first
+// parameter.
+template <class MoveTo, class LineTo, class ClosePath>
+void walkCommands(std::size_t count, const uint32_t* values, MoveTo moveTo, LineTo lineTo, ClosePath closePath) {
+    uint8_t cmd = 1;
+    uint32_t length = 0;
+    std::size_t i = 0;
+
+    while (i < count) {
+        if (length == 0) {
+            const uint32_t cmdLength = values[i++];
+            cmd = cmdLength & 0x7;
+            length = cmdLength >> 3;
+        }
+
+        --length;
+
+        if (cmd == 1 || cmd == 2) {
+            const std::size_t available = (count - i) / 2;
+            if (available == 0) {
+                throw std::runtime_error("truncated geometry");
+            }
+
+            if (cmd == 1) { // moveTo
+                moveTo(i);
+                i += 2;
+            } else {
+                const uint64_t remaining = uint64_t(length) + 1;
+                const std::size_t run = remaining < available ? std::size_t(remaining) : available;
+                lineTo(i, run);
+                i += 2 * run;
+                length -= uint32_t(run - 1);
+            }
+
+        } else if (cmd == 7) { // closePath
+            closePath();
+
+        } else {
+            throw std::runtime_error("unknown command");
+        }
+    }
+}
+
+// Stack storage for typical features, falling back to the heap for large ones.
+class Scratch {
+public:
+    explicit Scratch(std::size_t size)
+        : heap(size > stack.size() ? size : 0),
+          ptr(heap.empty() ? stack.data() : heap.data()) {
+    }
+
+    uint32_t* data() { return ptr; }
+
+private:
+    std::array<uint32_t, 2048> stack;
+    std::vector<uint32_t> heap;
+    uint32_t* ptr;
+};
+
+// Decodes the command stream into rings of the given sizes. The scaling of each point
+// is a template parameter so that the common unscaled case is a plain conversion.
+template <class Convert>
+GeometryCollection decodeRings(std::size_t count, uint32_t* values,
+                               const uint32_t* ringSizes, std::size_t rings,
+                               Convert convert) {
+    GeometryCollection lines;
+    lines.reserve(rings);
+
+    std::size_t ring = 0;
+    lines.emplace_back();
+    GeometryCoordinates* line = &lines.back();
+    line->reserve(ringSizes[ring]);
+
+    int32_t x = 0;
+    int32_t y = 0;
+
+    walkCommands(count, values,
+        [&] (std::size_t i) {
+            x += decodeZigzag(values[i]);
+            y += decodeZigzag(values[i + 1]);
+
+            if (!line->empty()) {
+                lines.emplace_back();
+                line = &lines.back();
+                line->reserve(ringSizes[++ring]);
+            }
+
+            line->push_back(convert(x, y));
+        },
+        [&] (std::size_t i, std::size_t run) {
+            decodeDeltas(values + i, run, x, y);
+            const int32_t* coordinates = reinterpret_cast<const int32_t*>(values + i);
+            GeometryCoordinates& current = *line;
+            for (std::size_t k = 0; k < run; k++) {
+                current.push_back(convert(coordinates[2 * k], coordinates[2 * k + 1]));
+            }
+        },
+        [&] () {
+            if (!line->empty()) {
+                line->push_back((*line)[0]);
+            }
+        });
+
+    return lines;
+}
+
+#if defined(__SSE2__) && (defined(__GNUC__) || defined(__clang__))
+#define MBGL_SIMD_VARINTS 1
+
+inline void widen16(__m128i bytes, uint32_t* out) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i lo = _mm_unpacklo_epi8(bytes, zero);
+    const __m128i hi = _mm_unpackhi_epi8(bytes, zero);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 0), _mm_unpacklo_epi16(lo, zero));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 4), _mm_unpackhi_epi16(lo, zero));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 8), _mm_unpacklo_epi16(hi, zero));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 12), _mm_unpackhi_epi16(hi, zero));
+}
+#endif
+
+} // namespace
+
+std::size_t decodeVarintsScalar(const char* data, std::size_t length, uint32_t* out) {
+    auto p = reinterpret_cast<const uint8_t*>(data);
+    const auto end = p + length;
+    uint32_t* o = out;
+    while (p < end) {
+        *o++ = decodeVarint(p, end);
+    }
+    return o - out;
+}
+
+std::size_t decodeVarints(const char* data, std::size_t length, uint32_t* out) {
+#if defined(MBGL_SIMD_VARINTS)
+    auto p = reinterpret_cast<const uint8_t*>(data);
+    const auto end = p + length;
+    uint32_t* o = out;
+
+    // Geometry deltas and command headers are mostly below 128, so they encode as
+    // single bytes. Each block is widened whole, and only the leading run of single-byte
+    // varints is kept. Writing beyond the run is safe: `out` has a slot for every input
+    // byte, and no more values than bytes have been consumed.
+    while (end - p >= 16) {
+#if defined(__AVX2__)
+        if (end - p >= 32) {
+            const __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+            if (_mm256_movemask_epi8(bytes) == 0) {
+                for (std::size_t k = 0; k < 32; k += 8) {
+                    const __m128i chunk = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(p + k));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(o + k), _mm256_cvtepu8_epi32(chunk));
+                }
+                p += 32;
+                o += 32;
+                continue;
+            }
+        }
+#endif
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        const unsigned mask = unsigned(_mm_movemask_epi8(bytes));
+        const unsigned run = mask ? unsigned(__builtin_ctz(mask)) : 16;
+        widen16(bytes, o);
+        p += run;
+        o += run;
+        if (run < 16) {
+            *o++ = decodeVarint(p, end);
+        }
+    }
+
+    while (p < end) {
+        *o++ = decodeVarint(p, end);
+    }
+    return o - out;
+#else
+    return decodeVarintsScalar(data, length, out);
+#endif
+}
+
+GeometryCollection decodeGeometry(const char* data, std::size_t length, uint32_t extent) {
+    // One scratch buffer holds the decoded values (at most one per byte), followed by
+    // the ring sizes (at most one per MoveTo, plus the initial ring).
+    Scratch scratch(2 * length + 1);
+    uint32_t* values = scratch.data();
+    uint32_t* ringSizes = values + length;
+    const std::size_t count = decodeVarints(data, length, values);
+
+    // First pass: measure each ring.
+    std::size_t rings = 0;
+    uint32_t ringSize = 0;
+    walkCommands(count, values,
+        [&] (std::size_t) {
+            if (ringSize) {
+                ringSizes[rings++] = ringSize;
+                ringSize = 0;
+            }
+            ringSize++;
+        },
+        [&] (std::size_t, std::size_t run) {
+            ringSize += run;
+        },
+        [&] () {
+            if (ringSize) {
+                ringSize++;
+            }
+        });
+    ringSizes[rings++] = ringSize;
+
+    // Second pass: decode coordinates into rings of the measured sizes. The usual
+    // extents scale by a whole factor, where rounding the scaled float is exact, so
+    // integer multiplication gives the same result.
+    const float scale = float(util::EXTENT) / extent;
+    if (scale == std::floor(scale) && scale <= std::numeric_limits<int16_t>::max()) {
+        const auto factor = uint32_t(scale);
+        return decodeRings(count, values, ringSizes, rings, [factor] (int32_t x, int32_t y) {
+            return GeometryCoordinate(int16_t(uint32_t(x) * factor), int16_t(uint32_t(y) * factor));
+        });
+    } else {
+        return decodeRings(count, values, ringSizes, rings, [scale] (int32_t x, int32_t y) {
+            return GeometryCoordinate(::round(x * scale), ::round(y * scale));
+        });
+    }
+}
+
+} // namespace mbgl
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <mbgl/tile/geometry_tile_data.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace mbgl {
+
+// Decodes the packed varints in [data, data + length) into `out`, which must have room
+// for `length` values, and returns the number of values decoded. Runs of single-byte
+// varints are widened with SSE2, or AVX2 where the build enables it.
+std::size_t decodeVarints(const char* data, std::size_t length, uint32_t* out);
+
+// The portable implementation of decodeVarints(), for comparison in tests and benchmarks.
+std::size_t decodeVarintsScalar(const char* data, std::size_t length, uint32_t* out);
+
+// Decodes a packed Mapbox Vector Tile geometry command stream into rings, scaling
+// coordinates from `extent` to util::EXTENT. The stream is decoded into a flat buffer
+// and measured before any ring is allocated, so that each ring is allocated once.
+GeometryCollection decodeGeometry(const char* data, std::size_t length, uint32_t extent);
+
+} // namespace mbgl
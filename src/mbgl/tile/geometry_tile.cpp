@@ -31,6 +31,7 @@ GeometryTile::GeometryTile(const OverscaledTileID& id_,
       mailbox(std::make_shared<Mailbox>(*util::RunLoop::Get())),
       worker(parameters.workerScheduler,
              ActorRef<GeometryTile>(*this, mailbox),
+             parameters.workerScheduler,
              id_,
              *parameters.style.glyphAtlas,
              obsolete,
@@ -45,6 +46,17 @@ void GeometryTile::cancel() {
     obsolete = true;
 }
 
+void GeometryTile::setNecessity(Necessity necessity) {
+    // Parse and layout work for tiles that are part of the current view is processed before
+    // work for tiles that are only retained, e.g. as a fallback or in the cache.
+    worker.setPriority(necessity == Necessity::Required ? Scheduler::Priority::High
+                                                        : Scheduler::Priority::Low);
+}
+
+void GeometryTile::prefetch() {
+    worker.setPriority(Scheduler::Priority::Low);
+}
+
 void GeometryTile::setError(std::exception_ptr err) {
     observer->onTileError(*this, err);
 }
@@ -58,7 +70,7 @@ void GeometryTile::setData(std::unique_ptr<const GeometryTileData> data_) {
 
     ++correlationID;
     worker.invoke(&GeometryTileWorker::setData, std::move(data_), correlationID);
-    redoLayout();
+    redoLayout({});
 }
 
 void GeometryTile::setPlacementConfig(const PlacementConfig& desiredConfig) {
@@ -81,7 +93,7 @@ void GeometryTile::symbolDependenciesChanged() {
     worker.invoke(&GeometryTileWorker::symbolDependenciesChanged);
 }
 
-void GeometryTile::redoLayout() {
+void GeometryTile::redoLayout(const std::unordered_set<std::string>& changedLayerIDs) {
     // Mark the tile as pending again if it was complete before to prevent signaling a complete
     // state despite pending parse operations.
     if (availableData == DataAvailability::All) {
@@ -105,7 +117,7 @@ void GeometryTile::redoLayout() {
     }
 
     ++correlationID;
-    worker.invoke(&GeometryTileWorker::setLayers, std::move(copy), correlationID);
+    worker.invoke(&GeometryTileWorker::setLayers, std::move(copy), changedLayerIDs, correlationID);
 }
 
 void GeometryTile::onLayout(LayoutResult result) {
@@ -142,6 +154,25 @@ Bucket* GeometryTile::getBucket(const Layer& layer) {
     return it->second.get();
 }
 
+MemoryUsage GeometryTile::memoryUsage() const {
+    MemoryUsage result;
+    result.cpu = (data ? data->bytes() : 0) +
+                 (featureIndex ? featureIndex->bytes() : 0) +
+                 (collisionTile ? collisionTile->bytes() : 0);
+
+    // Layers of the same layout group share a bucket.
+    std::unordered_set<const Bucket*> counted;
+    for (const auto& buckets : { &nonSymbolBuckets, &symbolBuckets }) {
+        for (const auto& pair : *buckets) {
+            if (counted.insert(pair.second.get()).second) {
+                result += pair.second->memoryUsage();
+            }
+        }
+    }
+
+    return result;
+}
+
 void GeometryTile::queryRenderedFeatures(
     std::unordered_map<std::string, std::vector<Feature>>& result,
     const GeometryCoordinates& queryGeometry,
@@ -183,17 +214,13 @@ void GeometryTile::querySourceFeatures(
         auto layer = data->getLayer(sourceLayer);
         
         if (layer) {
-            auto featureCount = layer->featureCount();
-            for (std::size_t i = 0; i < featureCount; i++) {
-                auto feature = layer->getFeature(i);
-
+            layer->eachFeature([&] (std::size_t, const GeometryTileFeature& feature) {
                 // Apply filter, if any
-                if (options.filter && !(*options.filter)(*feature)) {
-                    continue;
+                if (!options.filter || (*options.filter)(feature)) {
+                    result.push_back(convertFeature(feature, id.canonical));
                 }
-
-                result.push_back(convertFeature(*feature, id.canonical));
-            }
+                return true;
+            });
         }
     }
 }
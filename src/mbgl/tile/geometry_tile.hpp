@@ -32,14 +32,18 @@ public:
 
     ~GeometryTile() override;
 
+    void setNecessity(Necessity) override;
+    void prefetch() override;
+
     void setError(std::exception_ptr);
     void setData(std::unique_ptr<const GeometryTileData>);
 
     void setPlacementConfig(const PlacementConfig&) override;
     void symbolDependenciesChanged() override;
-    void redoLayout() override;
+    void redoLayout(const std::unordered_set<std::string>& changedLayerIDs) override;
 
     Bucket* getBucket(const style::Layer&) override;
+    MemoryUsage memoryUsage() const override;
 
     void queryRenderedFeatures(
             std::unordered_map<std::string, std::vector<Feature>>& result,
@@ -5,6 +5,15 @@
 
 namespace mbgl {
 
+void GeometryTileLayer::eachFeature(const FeatureVisitor& visitor) const {
+    const std::size_t count = featureCount();
+    for (std::size_t i = 0; i < count; i++) {
+        if (!visitor(i, *getFeature(i))) {
+            return;
+        }
+    }
+}
+
 static double signedArea(const GeometryCoordinates& ring) {
     double sum = 0;
 
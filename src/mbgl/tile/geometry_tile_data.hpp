@@ -8,6 +8,7 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <functional>
 
 namespace mbgl {
 
@@ -45,6 +46,10 @@ public:
     virtual PropertyMap getProperties() const { return PropertyMap(); }
     virtual optional<FeatureIdentifier> getID() const { return {}; }
     virtual GeometryCollection getGeometries() const = 0;
+
+    // For features of layers with a value table (see GeometryTileLayer::getValueTable), the
+    // index into that table of this feature's value for the given key index, if it has one.
+    virtual optional<uint32_t> getValueIndex(uint32_t) const { return {}; }
 };
 
 class GeometryTileLayer {
@@ -53,6 +58,19 @@ public:
     virtual std::size_t featureCount() const = 0;
     virtual std::unique_ptr<GeometryTileFeature> getFeature(std::size_t) const = 0;
     virtual std::string getName() const = 0;
+
+    // Layers whose features refer to property keys and values by index into tables shared
+    // by the whole layer, as vector tile layers do, expose the value table and key indices
+    // so that property lookups can be resolved once per layer rather than once per feature.
+    // Other layers return nullptr and none.
+    virtual const std::vector<Value>* getValueTable() const { return nullptr; }
+    virtual optional<uint32_t> getKeyIndex(const std::string&) const { return {}; }
+
+    // Visits each feature in order, stopping early if the visitor returns false. Unlike
+    // getFeature(), implementations need not allocate an owning feature per call, so the
+    // feature reference is only valid for the duration of the visit.
+    using FeatureVisitor = std::function<bool (std::size_t index, const GeometryTileFeature&)>;
+    virtual void eachFeature(const FeatureVisitor&) const;
 };
 
 class GeometryTileData {
@@ -60,6 +78,9 @@ public:
     virtual ~GeometryTileData() = default;
     virtual std::unique_ptr<GeometryTileData> clone() const = 0;
     virtual const GeometryTileLayer* getLayer(const std::string&) const = 0;
+
+    // An estimate of the memory used by the tile data.
+    virtual std::size_t bytes() const = 0;
 };
 
 // classifies an array of rings into polygons with outer rings and holes
@@ -1,13 +1,16 @@
 #include <mbgl/tile/geometry_tile_worker.hpp>
 #include <mbgl/tile/geometry_tile_data.hpp>
 #include <mbgl/tile/geometry_tile.hpp>
+#include <mbgl/tile/geometry_cache.hpp>
+#include <mbgl/actor/parallel_for.hpp>
+#include <mbgl/geometry/feature_index.hpp>
 #include <mbgl/text/collision_tile.hpp>
 #include <mbgl/text/glyph_atlas.hpp>
 #include <mbgl/layout/symbol_layout.hpp>
 #include <mbgl/style/bucket_parameters.hpp>
 #include <mbgl/style/group_by_layout.hpp>
 #include <mbgl/style/filter.hpp>
-#include <mbgl/style/filter_evaluator.hpp>
+#include <mbgl/style/compiled_filter.hpp>
 #include <mbgl/style/layers/symbol_layer.hpp>
 #include <mbgl/style/layers/symbol_layer_impl.hpp>
 #include <mbgl/renderer/symbol_bucket.hpp>
@@ -16,20 +19,45 @@
 #include <mbgl/util/string.hpp>
 #include <mbgl/util/exception.hpp>
 
+#include <mapbox/geometry/envelope.hpp>
+
 #include <unordered_set>
 
 namespace mbgl {
 
 using namespace style;
 
+// For a non-symbol layer group, the bucket and the envelope of each ring of the features
+// added to it, in order, for inserting into the FeatureIndex. For a symbol layer group,
+// the symbol layout.
+class GeometryTileWorker::GroupLayout {
+public:
+    std::shared_ptr<Bucket> bucket;
+    bool hasData = false; // Cached, as the bucket may be in use on the main thread.
+    std::vector<std::pair<std::size_t, GridIndex<IndexedSubfeature>::BBox>> rings;
+
+    std::unique_ptr<SymbolLayout> symbolLayout;
+};
+
+static std::string groupKey(const std::vector<const Layer*>& group) {
+    std::string key = layoutKey(*group.at(0));
+    for (const auto& layer : group) {
+        key += '\0';
+        key += layer->getID();
+    }
+    return key;
+}
+
 GeometryTileWorker::GeometryTileWorker(ActorRef<GeometryTileWorker> self_,
                                        ActorRef<GeometryTile> parent_,
+                                       Scheduler& scheduler_,
                                        OverscaledTileID id_,
                                        GlyphAtlas& glyphAtlas_,
                                        const std::atomic<bool>& obsolete_,
                                        const MapMode mode_)
     : self(std::move(self_)),
       parent(std::move(parent_)),
+      scheduler(scheduler_),
       id(std::move(id_)),
       glyphAtlas(glyphAtlas_),
       obsolete(obsolete_),
@@ -76,6 +104,7 @@ GeometryTileWorker::~GeometryTileWorker() {
 void GeometryTileWorker::setData(std::unique_ptr<const GeometryTileData> data_, uint64_t correlationID_) {
     try {
         data = std::move(data_);
+        dataChanged = true;
         correlationID = correlationID_;
 
         switch (state) {
@@ -95,9 +124,12 @@ void GeometryTileWorker::setData(std::unique_ptr<const GeometryTileData> data_,
     }
 }
 
-void GeometryTileWorker::setLayers(std::vector<std::unique_ptr<Layer>> layers_, uint64_t correlationID_) {
+void GeometryTileWorker::setLayers(std::vector<std::unique_ptr<Layer>> layers_,
+                                   std::unordered_set<std::string> changedLayerIDs_,
+                                   uint64_t correlationID_) {
     try {
         layers = std::move(layers_);
+        changedLayerIDs.insert(changedLayerIDs_.begin(), changedLayerIDs_.end());
         correlationID = correlationID_;
 
         switch (state) {
@@ -204,6 +236,9 @@ void GeometryTileWorker::redoLayout() {
         return;
     }
 
+    // Symbol layouts are owned by `groupLayouts`, which is taken apart below.
+    symbolLayouts.clear();
+
     std::vector<std::string> symbolOrder;
     for (auto it = layers->rbegin(); it != layers->rend(); it++) {
         if ((*it)->is<SymbolLayer>()) {
@@ -211,28 +246,105 @@ void GeometryTileWorker::redoLayout() {
         }
     }
 
-    std::unordered_map<std::string, std::unique_ptr<SymbolLayout>> symbolLayoutMap;
+    std::unordered_map<std::string, SymbolLayout*> symbolLayoutMap;
     std::unordered_map<std::string, std::shared_ptr<Bucket>> buckets;
     auto featureIndex = std::make_unique<FeatureIndex>();
     BucketParameters parameters { id, mode };
 
     std::vector<std::vector<const Layer*>> groups = groupByLayout(*layers);
-    for (auto& group : groups) {
+
+    // Source layers are looked up in advance: GeometryTileData may parse them lazily and
+    // isn't safe to use from several threads, whereas reading the layers themselves is.
+    std::vector<const GeometryTileLayer*> geometryLayers(groups.size(), nullptr);
+    if (*data) {
+        for (std::size_t i = 0; i < groups.size(); ++i) {
+            geometryLayers[i] = (*data)->getLayer(groups[i].at(0)->baseImpl->sourceLayer);
+        }
+    }
+
+    // Reuse the previous layout of groups that are unchanged.
+    std::vector<std::string> keys(groups.size());
+    std::vector<std::unique_ptr<GroupLayout>> layouts(groups.size());
+    for (std::size_t i = 0; i < groups.size(); ++i) {
+        keys[i] = groupKey(groups[i]);
+        if (dataChanged) {
+            continue;
+        }
+
+        auto it = groupLayouts.find(keys[i]);
+        if (it == groupLayouts.end() || !it->second) {
+            continue;
+        }
+
+        bool changed = false;
+        for (const auto& layer : groups[i]) {
+            changed = changed || changedLayerIDs.count(layer->getID());
+        }
+        if (!changed) {
+            layouts[i] = std::move(it->second);
+        }
+    }
+
+    // The buckets of groups that read the same source layer are built by one task, so
+    // that they share its decoded geometry. Tasks for different source layers run in
+    // parallel; symbol layouts are created afterwards, on this thread.
+    std::vector<std::vector<std::size_t>> tasks;
+    std::unordered_map<const GeometryTileLayer*, std::size_t> taskIndices;
+    for (std::size_t i = 0; i < groups.size(); ++i) {
+        if (geometryLayers[i] && !layouts[i] && !groups[i].at(0)->is<SymbolLayer>()) {
+            auto it = taskIndices.emplace(geometryLayers[i], tasks.size()).first;
+            if (it->second == tasks.size()) {
+                tasks.emplace_back();
+            }
+            tasks[it->second].push_back(i);
+            layouts[i] = std::make_unique<GroupLayout>();
+        }
+    }
+
+    parallelFor(scheduler, tasks.size(), [&] (std::size_t task) {
+        GeometryCache geometryCache;
+
+        for (std::size_t i : tasks[task]) {
+            const std::vector<const Layer*>& group = groups[i];
+            const Layer& leader = *group.at(0);
+            const GeometryTileLayer& geometryLayer = *geometryLayers[i];
+            const CompiledFilter filter(leader.baseImpl->filter, geometryLayer);
+            GroupLayout& layout = *layouts[i];
+
+            layout.bucket = leader.baseImpl->createBucket(parameters, group);
+
+            geometryLayer.eachFeature([&] (std::size_t index, const GeometryTileFeature& feature) {
+                if (obsolete) {
+                    return false;
+                }
+
+                if (!filter(feature))
+                    return true;
+
+                const GeometryCollection& geometries = geometryCache.getGeometries(geometryLayer, index, feature);
+                layout.bucket->addFeature(feature, geometries);
+                for (const auto& ring : geometries) {
+                    layout.rings.emplace_back(index, mapbox::geometry::envelope(ring));
+                }
+                return true;
+            });
+
+            layout.hasData = layout.bucket->hasData();
+        }
+    });
+
+    for (std::size_t i = 0; i < groups.size(); ++i) {
         if (obsolete) {
             return;
         }
 
-        if (!*data) {
-            continue; // Tile has no data.
+        if (!geometryLayers[i]) {
+            continue; // Tile has no data, or no data for this source layer.
         }
 
+        const std::vector<const Layer*>& group = groups[i];
         const Layer& leader = *group.at(0);
 
-        auto geometryLayer = (*data)->getLayer(leader.baseImpl->sourceLayer);
-        if (!geometryLayer) {
-            continue;
-        }
-
         std::vector<std::string> layerIDs;
         for (const auto& layer : group) {
             layerIDs.push_back(layer->getID());
@@ -241,39 +353,44 @@ void GeometryTileWorker::redoLayout() {
         featureIndex->setBucketLayerIDs(leader.getID(), layerIDs);
 
         if (leader.is<SymbolLayer>()) {
-            symbolLayoutMap.emplace(leader.getID(),
-                leader.as<SymbolLayer>()->impl->createLayout(parameters, group, *geometryLayer));
+            if (!layouts[i]) {
+                layouts[i] = std::make_unique<GroupLayout>();
+                layouts[i]->symbolLayout =
+                    leader.as<SymbolLayer>()->impl->createLayout(parameters, group, *geometryLayers[i]);
+            }
+            symbolLayoutMap.emplace(leader.getID(), layouts[i]->symbolLayout.get());
         } else {
-            const Filter& filter = leader.baseImpl->filter;
+            // Index features in group order, so that the index is the same as if the
+            // groups had been laid out one after another.
             const std::string& sourceLayerID = leader.baseImpl->sourceLayer;
-            std::shared_ptr<Bucket> bucket = leader.baseImpl->createBucket(parameters, group);
-
-            for (std::size_t i = 0; !obsolete && i < geometryLayer->featureCount(); i++) {
-                std::unique_ptr<GeometryTileFeature> feature = geometryLayer->getFeature(i);
-
-                if (!filter(feature->getType(), feature->getID(), [&] (const auto& key) { return feature->getValue(key); }))
-                    continue;
-
-                GeometryCollection geometries = feature->getGeometries();
-                bucket->addFeature(*feature, geometries);
-                featureIndex->insert(geometries, i, sourceLayerID, leader.getID());
+            const GroupLayout& layout = *layouts[i];
+            for (const auto& ring : layout.rings) {
+                featureIndex->insert(ring.second, ring.first, sourceLayerID, leader.getID());
             }
 
-            if (!bucket->hasData()) {
+            if (!layout.hasData) {
                 continue;
             }
 
             for (const auto& layer : group) {
-                buckets.emplace(layer->getID(), bucket);
+                buckets.emplace(layer->getID(), layout.bucket);
             }
         }
     }
 
-    symbolLayouts.clear();
+    groupLayouts.clear();
+    for (std::size_t i = 0; i < groups.size(); ++i) {
+        if (layouts[i]) {
+            groupLayouts.emplace(std::move(keys[i]), std::move(layouts[i]));
+        }
+    }
+    changedLayerIDs.clear();
+    dataChanged = false;
+
     for (const auto& symbolLayerID : symbolOrder) {
         auto it = symbolLayoutMap.find(symbolLayerID);
         if (it != symbolLayoutMap.end()) {
-            symbolLayouts.push_back(std::move(it->second));
+            symbolLayouts.push_back(it->second);
         }
     }
 
@@ -8,10 +8,15 @@
 
 #include <atomic>
 #include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 namespace mbgl {
 
 class GeometryTile;
+class Scheduler;
 class GeometryTileData;
 class GlyphAtlas;
 class SymbolLayout;
@@ -24,13 +29,16 @@ class GeometryTileWorker {
 public:
     GeometryTileWorker(ActorRef<GeometryTileWorker> self,
                        ActorRef<GeometryTile> parent,
+                       Scheduler&,
                        OverscaledTileID,
                        GlyphAtlas&,
                        const std::atomic<bool>&,
                        const MapMode);
     ~GeometryTileWorker();
 
-    void setLayers(std::vector<std::unique_ptr<style::Layer>>, uint64_t correlationID);
+    void setLayers(std::vector<std::unique_ptr<style::Layer>>,
+                   std::unordered_set<std::string> changedLayerIDs,
+                   uint64_t correlationID);
     void setData(std::unique_ptr<const GeometryTileData>, uint64_t correlationID);
     void setPlacementConfig(PlacementConfig, uint64_t correlationID);
     void symbolDependenciesChanged();
@@ -44,6 +52,7 @@ private:
 
     ActorRef<GeometryTileWorker> self;
     ActorRef<GeometryTile> parent;
+    Scheduler& scheduler;
 
     const OverscaledTileID id;
     GlyphAtlas& glyphAtlas;
@@ -65,7 +74,15 @@ private:
     optional<std::unique_ptr<const GeometryTileData>> data;
     optional<PlacementConfig> placementConfig;
 
-    std::vector<std::unique_ptr<SymbolLayout>> symbolLayouts;
+    // The result of the last layout for each layer group, by group key. A group is laid out
+    // again only if it's new, the data has changed, or one of its layers has changed.
+    class GroupLayout;
+    std::unordered_map<std::string, std::unique_ptr<GroupLayout>> groupLayouts;
+    std::unordered_set<std::string> changedLayerIDs;
+    bool dataChanged = true;
+
+    // Symbol layouts of `groupLayouts`, in placement order.
+    std::vector<SymbolLayout*> symbolLayouts;
 };
 
 } // namespace mbgl
@@ -10,16 +10,37 @@
 #include <mbgl/renderer/raster_bucket.hpp>
 #include <mbgl/util/run_loop.hpp>
 
+#include <cmath>
+
 namespace mbgl {
 
+namespace {
+
+// The largest size the tile is drawn at. Raster sources round to the nearest zoom level, so
+// that a tile covers up to √2 times its size. Tiles at the maximum zoom level of the source
+// may be overzoomed and are decoded at full resolution.
+Size maximumDrawnSize(const OverscaledTileID& id, const Tileset& tileset,
+                      uint16_t tileSize, float pixelRatio) {
+    if (id.canonical.z >= tileset.zoomRange.max) {
+        return {};
+    }
+
+    const auto size = static_cast<uint32_t>(std::ceil(tileSize * pixelRatio * std::sqrt(2.0)));
+    return { size, size };
+}
+
+} // namespace
+
 RasterTile::RasterTile(const OverscaledTileID& id_,
                        const style::UpdateParameters& parameters,
-                       const Tileset& tileset)
+                       const Tileset& tileset,
+                       uint16_t tileSize)
     : Tile(id_),
       loader(*this, id_, parameters, tileset),
       mailbox(std::make_shared<Mailbox>(*util::RunLoop::Get())),
       worker(parameters.workerScheduler,
-             ActorRef<RasterTile>(*this, mailbox)) {
+             ActorRef<RasterTile>(*this, mailbox),
+             maximumDrawnSize(id_, tileset, tileSize, parameters.pixelRatio)) {
 }
 
 RasterTile::~RasterTile() = default;
@@ -55,8 +76,20 @@ Bucket* RasterTile::getBucket(const style::Layer&) {
     return bucket.get();
 }
 
+MemoryUsage RasterTile::memoryUsage() const {
+    return bucket ? bucket->memoryUsage() : MemoryUsage();
+}
+
 void RasterTile::setNecessity(Necessity necessity) {
+    // Decode tiles that are part of the current view first.
+    worker.setPriority(necessity == Necessity::Required ? Scheduler::Priority::High
+                                                        : Scheduler::Priority::Low);
     loader.setNecessity(necessity);
 }
 
+void RasterTile::prefetch() {
+    worker.setPriority(Scheduler::Priority::Low);
+    loader.setNecessity(Necessity::Required);
+}
+
 } // namespace mbgl
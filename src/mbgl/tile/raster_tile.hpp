@@ -18,10 +18,12 @@ class RasterTile : public Tile {
 public:
     RasterTile(const OverscaledTileID&,
                    const style::UpdateParameters&,
-                   const Tileset&);
+                   const Tileset&,
+                   uint16_t tileSize);
     ~RasterTile() final;
 
     void setNecessity(Necessity) final;
+    void prefetch() final;
 
     void setError(std::exception_ptr);
     void setData(std::shared_ptr<const std::string> data,
@@ -30,6 +32,7 @@ public:
 
     void cancel() override;
     Bucket* getBucket(const style::Layer&) override;
+    MemoryUsage memoryUsage() const override;
 
     void onParsed(std::unique_ptr<Bucket> result);
     void onError(std::exception_ptr);
@@ -2,12 +2,14 @@
 #include <mbgl/tile/raster_tile.hpp>
 #include <mbgl/renderer/raster_bucket.hpp>
 #include <mbgl/actor/actor.hpp>
-#include <mbgl/util/premultiply.hpp>
 
 namespace mbgl {
 
-RasterTileWorker::RasterTileWorker(ActorRef<RasterTileWorker>, ActorRef<RasterTile> parent_)
-    : parent(std::move(parent_)) {
+RasterTileWorker::RasterTileWorker(ActorRef<RasterTileWorker>,
+                                   ActorRef<RasterTile> parent_,
+                                   Size targetSize_)
+    : parent(std::move(parent_)),
+      targetSize(targetSize_) {
 }
 
 void RasterTileWorker::parse(std::shared_ptr<const std::string> data) {
@@ -17,7 +19,7 @@ void RasterTileWorker::parse(std::shared_ptr<const std::string> data) {
     }
 
     try {
-        auto bucket = std::make_unique<RasterBucket>(util::unpremultiply(decodeImage(*data)));
+        auto bucket = std::make_unique<RasterBucket>(decodeUnassociatedImage(*data, targetSize));
         parent.invoke(&RasterTile::onParsed, std::move(bucket));
     } catch (...) {
         parent.invoke(&RasterTile::onError, std::current_exception());
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <mbgl/actor/actor_ref.hpp>
+#include <mbgl/util/size.hpp>
 
 #include <memory>
 #include <string>
@@ -11,12 +12,16 @@ class RasterTile;
 
 class RasterTileWorker {
 public:
-    RasterTileWorker(ActorRef<RasterTileWorker>, ActorRef<RasterTile>);
+    RasterTileWorker(ActorRef<RasterTileWorker>, ActorRef<RasterTile>, Size targetSize);
 
     void parse(std::shared_ptr<const std::string> data);
 
 private:
     ActorRef<RasterTile> parent;
+
+    // The largest size the tile is drawn at, or empty if that has no bound; larger images
+    // are decoded at a reduced size where the format allows it.
+    const Size targetSize;
 };
 
 } // namespace mbgl
@@ -14,6 +14,7 @@
 #include <memory>
 #include <functional>
 #include <unordered_map>
+#include <unordered_set>
 
 namespace mbgl {
 
@@ -44,14 +45,25 @@ public:
 
     virtual void setNecessity(Necessity) = 0;
 
+    // Marks the tile as one that the camera is about to show. Its data is requested as for a
+    // required tile, but its processing waits for the work of the tiles in view. Calling
+    // setNecessity() ends this state.
+    virtual void prefetch() {}
+
     // Mark this tile as no longer needed and cancel any pending work.
     virtual void cancel() = 0;
 
     virtual Bucket* getBucket(const style::Layer&) = 0;
 
+    // The memory used by the tile's buckets, data and indexes.
+    virtual MemoryUsage memoryUsage() const = 0;
+
     virtual void setPlacementConfig(const PlacementConfig&) {}
     virtual void symbolDependenciesChanged() {};
-    virtual void redoLayout() {}
+
+    // Lays out the tile again for the current style. Buckets of layer groups whose layout
+    // and layers are unchanged may be reused, unless they contain one of `changedLayerIDs`.
+    virtual void redoLayout(const std::unordered_set<std::string>& /* changedLayerIDs */) {}
 
     virtual void queryRenderedFeatures(
             std::unordered_map<std::string, std::vector<Feature>>& result,
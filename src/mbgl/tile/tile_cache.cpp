@@ -5,49 +5,115 @@
 
 namespace mbgl {
 
-void TileCache::setSize(size_t size_) {
-    size = size_;
+TileCache::Budget::~Budget() {
+    assert(entries.empty());
+}
+
+void TileCache::Budget::setMaxBytes(std::size_t maxBytes_) {
+    maxBytes = maxBytes_;
+    evict();
+}
+
+TileCache::Budget::Entries::iterator
+TileCache::Budget::insert(TileCache& cache,
+                          const OverscaledTileID& key,
+                          std::unique_ptr<Tile> tile,
+                          std::size_t tileBytes) {
+    bytes += tileBytes;
+    cache.bytes += tileBytes;
+    return entries.insert(entries.end(), Entry { cache, key, std::move(tile), tileBytes });
+}
 
-    while (orderedKeys.size() > size) {
-        auto key = orderedKeys.front();
-        orderedKeys.pop_front();
-        tiles.erase(key);
+std::unique_ptr<Tile> TileCache::Budget::erase(Entries::iterator it) {
+    std::unique_ptr<Tile> tile = std::move(it->tile);
+    bytes -= it->bytes;
+    it->cache.bytes -= it->bytes;
+    it->cache.index.erase(it->key);
+    entries.erase(it);
+    return tile;
+}
+
+void TileCache::Budget::evict() {
+    while (bytes > maxBytes) {
+        assert(!entries.empty());
+        erase(entries.begin());
     }
+}
 
-    assert(orderedKeys.size() <= size);
+std::size_t TileCache::tileBytes(const Tile& tile) {
+    return tile.memoryUsage().total() + tileOverhead();
 }
 
-void TileCache::add(const OverscaledTileID& key, std::unique_ptr<Tile> tile) {
-    if (!tile->isRenderable() || !size) {
+std::size_t TileCache::tileOverhead() {
+    return sizeof(Tile) + sizeof(Budget::Entry);
+}
+
+TileCache::TileCache(std::size_t maxBytes)
+    : budget(std::make_shared<Budget>(maxBytes)) {
+}
+
+TileCache::TileCache(std::shared_ptr<Budget> budget_)
+    : budget(std::move(budget_)) {
+    assert(budget);
+}
+
+TileCache::~TileCache() {
+    clear();
+}
+
+void TileCache::setBudget(std::shared_ptr<Budget> budget_) {
+    if (!budget_) {
+        budget_ = std::make_shared<Budget>(budget->getMaxBytes());
+    }
+    if (budget_ == budget) {
         return;
     }
 
-    // insert new or query existing tile
-    if (tiles.emplace(key, std::move(tile)).second) {
-        // remove existing tile key
-        orderedKeys.remove(key);
+    // Move the entries in their order of use; splicing keeps the iterators in `index` valid.
+    for (auto it = budget->entries.begin(); it != budget->entries.end();) {
+        auto next = std::next(it);
+        if (&it->cache == this) {
+            budget->bytes -= it->bytes;
+            budget_->bytes += it->bytes;
+            budget_->entries.splice(budget_->entries.end(), budget->entries, it);
+        }
+        it = next;
     }
 
-    // (re-)insert tile key as newest
-    orderedKeys.push_back(key);
+    budget = std::move(budget_);
+    budget->evict();
+}
+
+void TileCache::setMaxBytes(std::size_t maxBytes) {
+    budget->setMaxBytes(maxBytes);
+}
+
+void TileCache::add(const OverscaledTileID& key, std::unique_ptr<Tile> tile) {
+    if (!tile->isRenderable()) {
+        return;
+    }
+
+    const std::size_t entryBytes = tileBytes(*tile);
+    if (entryBytes > budget->getMaxBytes()) {
+        return;
+    }
 
-    // purge oldest key/tile if necessary
-    if (orderedKeys.size() > size) {
-        get(orderedKeys.front());
+    // A newer tile replaces the cached one.
+    auto it = index.find(key);
+    if (it != index.end()) {
+        budget->erase(it->second);
     }
 
-    assert(orderedKeys.size() <= size);
+    index.emplace(key, budget->insert(*this, key, std::move(tile), entryBytes));
+    budget->evict();
 }
 
 std::unique_ptr<Tile> TileCache::get(const OverscaledTileID& key) {
-
     std::unique_ptr<Tile> tile;
 
-    auto it = tiles.find(key);
-    if (it != tiles.end()) {
-        tile = std::move(it->second);
-        tiles.erase(it);
-        orderedKeys.remove(key);
+    auto it = index.find(key);
+    if (it != index.end()) {
+        tile = budget->erase(it->second);
         assert(tile->isRenderable());
     }
 
@@ -55,12 +121,29 @@ std::unique_ptr<Tile> TileCache::get(const OverscaledTileID& key) {
 }
 
 bool TileCache::has(const OverscaledTileID& key) {
-    return tiles.find(key) != tiles.end();
+    return index.find(key) != index.end();
 }
 
 void TileCache::clear() {
-    orderedKeys.clear();
-    tiles.clear();
+    while (!index.empty()) {
+        budget->erase(index.begin()->second);
+    }
+    assert(bytes == 0);
+}
+
+void TileCache::removeIf(const std::function<bool (const OverscaledTileID&)>& predicate) {
+    for (auto it = index.begin(); it != index.end();) {
+        auto entry = (it++)->second;
+        if (predicate(entry->key)) {
+            budget->erase(entry);
+        }
+    }
+}
+
+void TileCache::forEach(const std::function<void (Tile&)>& fn) const {
+    for (const auto& pair : index) {
+        fn(*pair.second->tile);
+    }
 }
 
 } // namespace mbgl
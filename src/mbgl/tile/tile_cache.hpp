@@ -1,31 +1,90 @@
 #pragma once
 
 #include <mbgl/tile/tile_id.hpp>
+#include <mbgl/util/noncopyable.hpp>
 
+#include <functional>
 #include <list>
 #include <memory>
-#include <map>
+#include <unordered_map>
 
 namespace mbgl {
 
 class Tile;
 
-class TileCache {
+// A least recently used cache of tiles that are no longer needed for rendering, limited
+// by the memory the tiles use rather than by their number. All operations except
+// `removeIf` take constant time.
+class TileCache : private util::noncopyable {
 public:
-    TileCache(size_t size_ = 0) : size(size_) {}
+    // A memory budget, and the order in which the tiles it covers were last used. A budget
+    // can be shared by the caches of several sources; the least recently used tile of any
+    // of them is then evicted first.
+    class Budget : private util::noncopyable {
+    public:
+        Budget(std::size_t maxBytes_ = 0) : maxBytes(maxBytes_) {}
+        ~Budget();
+
+        void setMaxBytes(std::size_t);
+        std::size_t getMaxBytes() const { return maxBytes; }
+        std::size_t getBytes() const { return bytes; }
+
+    private:
+        friend class TileCache;
+
+        struct Entry {
+            TileCache& cache;
+            OverscaledTileID key;
+            std::unique_ptr<Tile> tile;
+            std::size_t bytes;
+        };
+        using Entries = std::list<Entry>;
+
+        Entries::iterator insert(TileCache&, const OverscaledTileID&, std::unique_ptr<Tile>, std::size_t bytes);
+        std::unique_ptr<Tile> erase(Entries::iterator);
+        void evict();
+
+        // Least recently used first.
+        Entries entries;
+        std::size_t maxBytes;
+        std::size_t bytes = 0;
+    };
+
+    // The memory charged to the budget for a tile: what it uses, plus the tile object and
+    // its cache entry, so that empty tiles are limited as well.
+    static std::size_t tileBytes(const Tile&);
+    static std::size_t tileOverhead();
+
+    // Uses a budget of its own.
+    TileCache(std::size_t maxBytes = 0);
+    TileCache(std::shared_ptr<Budget>);
+    ~TileCache();
+
+    // Moves the cached tiles to `budget`, or to a budget of its own when it is null.
+    void setBudget(std::shared_ptr<Budget>);
+    bool hasSharedBudget() const { return budget.use_count() > 1; }
+
+    void setMaxBytes(std::size_t);
+    std::size_t getMaxBytes() const { return budget->getMaxBytes(); }
+
+    // The memory used by the tiles of this cache, which may share its budget with others.
+    std::size_t getBytes() const { return bytes; }
+    std::size_t size() const { return index.size(); }
 
-    void setSize(size_t);
-    size_t getSize() const { return size; };
     void add(const OverscaledTileID& key, std::unique_ptr<Tile> data);
     std::unique_ptr<Tile> get(const OverscaledTileID& key);
     bool has(const OverscaledTileID& key);
     void clear();
 
-private:
-    std::map<OverscaledTileID, std::unique_ptr<Tile>> tiles;
-    std::list<OverscaledTileID> orderedKeys;
+    // Removes the tiles for which `predicate` returns true.
+    void removeIf(const std::function<bool (const OverscaledTileID&)>& predicate);
+
+    void forEach(const std::function<void (Tile&)>&) const;
 
-    size_t size;
+private:
+    std::shared_ptr<Budget> budget;
+    std::unordered_map<OverscaledTileID, Budget::Entries::iterator> index;
+    std::size_t bytes = 0;
 };
 
 } // namespace mbgl
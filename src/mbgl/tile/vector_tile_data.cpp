@@ -0,0 +1,223 @@
+#include <mbgl/tile/vector_tile_data.hpp>
+#include <mbgl/tile/geometry_decoder.hpp>
+
+namespace mbgl {
+
+Value parseValue(protozero::pbf_reader data) {
+    while (data.next())
+    {
+        switch (data.tag()) {
+        case 1: // string_value
+            return data.get_string();
+        case 2: // float_value
+            return static_cast<double>(data.get_float());
+        case 3: // double_value
+            return data.get_double();
+        case 4: // int_value
+            return data.get_int64();
+        case 5: // uint_value
+            return data.get_uint64();
+        case 6: // sint_value
+            return data.get_sint64();
+        case 7: // bool_value
+            return data.get_bool();
+        default:
+            data.skip();
+            break;
+        }
+    }
+    return false;
+}
+
+VectorTileFeature::VectorTileFeature(protozero::pbf_reader feature_pbf, std::shared_ptr<const VectorTileLayerData> layerData_)
+    : VectorTileFeature(std::move(feature_pbf), *layerData_) {
+    layerDataOwner = std::move(layerData_);
+}
+
+VectorTileFeature::VectorTileFeature(protozero::pbf_reader feature_pbf, const VectorTileLayerData& layerData_)
+    : layerData(layerData_) {
+    while (feature_pbf.next()) {
+        switch (feature_pbf.tag()) {
+        case 1: // id
+            id = { feature_pbf.get_uint64() };
+            break;
+        case 2: // tags
+            tags_iter = feature_pbf.get_packed_uint32();
+            break;
+        case 3: // type
+            type = static_cast<FeatureType>(feature_pbf.get_enum());
+            break;
+        case 4: // geometry
+            geometry = feature_pbf.get_data();
+            break;
+        default:
+            feature_pbf.skip();
+            break;
+        }
+    }
+}
+
+optional<Value> VectorTileFeature::getValue(const std::string& key) const {
+    auto keyIter = layerData.keysMap.find(key);
+    if (keyIter == layerData.keysMap.end()) {
+        return optional<Value>();
+    }
+
+    optional<uint32_t> valueIndex = getValueIndex(keyIter->second);
+    if (!valueIndex) {
+        return optional<Value>();
+    }
+
+    return layerData.values[*valueIndex];
+}
+
+optional<uint32_t> VectorTileFeature::getValueIndex(uint32_t keyIndex) const {
+    auto start_itr = tags_iter.begin();
+    const auto & end_itr = tags_iter.end();
+    while (start_itr != end_itr) {
+        uint32_t tag_key = static_cast<uint32_t>(*start_itr++);
+
+        if (layerData.keysMap.size() <= tag_key) {
+            throw std::runtime_error("feature referenced out of range key");
+        }
+
+        if (start_itr == end_itr) {
+            throw std::runtime_error("uneven number of feature tag ids");
+        }
+
+        uint32_t tag_val = static_cast<uint32_t>(*start_itr++);
+        if (layerData.values.size() <= tag_val) {
+            throw std::runtime_error("feature referenced out of range value");
+        }
+
+        if (tag_key == keyIndex) {
+            return tag_val;
+        }
+    }
+
+    return optional<uint32_t>();
+}
+
+std::unordered_map<std::string,Value> VectorTileFeature::getProperties() const {
+    std::unordered_map<std::string,Value> properties;
+    auto start_itr = tags_iter.begin();
+    const auto & end_itr = tags_iter.end();
+    while (start_itr != end_itr) {
+        uint32_t tag_key = static_cast<uint32_t>(*start_itr++);
+        if (start_itr == end_itr) {
+            throw std::runtime_error("uneven number of feature tag ids");
+        }
+        uint32_t tag_val = static_cast<uint32_t>(*start_itr++);
+        properties[layerData.keys.at(tag_key)] = layerData.values.at(tag_val);
+    }
+    return properties;
+}
+
+optional<FeatureIdentifier> VectorTileFeature::getID() const {
+    return id;
+}
+
+GeometryCollection VectorTileFeature::getGeometries() const {
+    GeometryCollection lines = decodeGeometry(geometry.first, geometry.second, layerData.extent);
+
+    if (layerData.version >= 2 || type != FeatureType::Polygon) {
+        return lines;
+    }
+
+    return fixupPolygons(lines);
+}
+
+VectorTileData::VectorTileData(std::shared_ptr<const std::string> data_)
+    : data(std::move(data_)) {
+}
+
+// Layers and features are read from the encoded tile in place.
+std::size_t VectorTileData::bytes() const {
+    return data->size();
+}
+
+const GeometryTileLayer* VectorTileData::getLayer(const std::string& name) const {
+    if (!parsed) {
+        parsed = true;
+        protozero::pbf_reader tile_pbf(*data);
+        while (tile_pbf.next(3)) {
+            VectorTileLayer layer(tile_pbf.get_message(), data);
+            layers.emplace(layer.name, std::move(layer));
+        }
+    }
+
+    auto it = layers.find(name);
+    if (it != layers.end()) {
+        return &it->second;
+    }
+    return nullptr;
+}
+
+VectorTileLayerData::VectorTileLayerData(std::shared_ptr<const std::string> pbfData) :
+    data(std::move(pbfData))
+{}
+
+VectorTileLayer::VectorTileLayer(protozero::pbf_reader layer_pbf, std::shared_ptr<const std::string> pbfData)
+    : data(std::make_shared<VectorTileLayerData>(std::move(pbfData)))
+{
+    while (layer_pbf.next()) {
+        switch (layer_pbf.tag()) {
+        case 1: // name
+            name = layer_pbf.get_string();
+            break;
+        case 2: // feature
+            features.push_back(layer_pbf.get_message());
+            break;
+        case 3: // keys
+            {
+                auto iter = data->keysMap.emplace(layer_pbf.get_string(), data->keysMap.size());
+                data->keys.emplace_back(std::reference_wrapper<const std::string>(iter.first->first));
+            }
+            break;
+        case 4: // values
+            data->values.emplace_back(parseValue(layer_pbf.get_message()));
+            break;
+        case 5: // extent
+            data->extent = layer_pbf.get_uint32();
+            break;
+        case 15: // version
+            data->version = layer_pbf.get_uint32();
+            break;
+        default:
+            layer_pbf.skip();
+            break;
+        }
+    }
+}
+
+std::unique_ptr<GeometryTileFeature> VectorTileLayer::getFeature(std::size_t i) const {
+    return std::make_unique<VectorTileFeature>(features.at(i), data);
+}
+
+void VectorTileLayer::eachFeature(const FeatureVisitor& visitor) const {
+    // The layer data outlives the visit, so features can borrow it rather than
+    // each taking a reference count, and live on the stack rather than the heap.
+    for (std::size_t i = 0; i < features.size(); i++) {
+        if (!visitor(i, VectorTileFeature(features[i], *data))) {
+            return;
+        }
+    }
+}
+
+std::string VectorTileLayer::getName() const {
+    return name;
+}
+
+const std::vector<Value>* VectorTileLayer::getValueTable() const {
+    return &data->values;
+}
+
+optional<uint32_t> VectorTileLayer::getKeyIndex(const std::string& key) const {
+    auto it = data->keysMap.find(key);
+    if (it == data->keysMap.end()) {
+        return optional<uint32_t>();
+    }
+    return it->second;
+}
+
+} // namespace mbgl
@@ -1,7 +1,9 @@
 #include <mbgl/util/compression.hpp>
+#include <mbgl/util/thread_local.hpp>
 
 #include <zlib.h>
 
+#include <algorithm>
 #include <cstdio>
 #include <cstring>
 #include <stdexcept>
@@ -27,74 +29,118 @@ namespace util {
 // cause a link error.
 #undef z_compress
 
-std::string compress(const std::string &raw) {
-    z_stream deflate_stream;
-    memset(&deflate_stream, 0, sizeof(deflate_stream));
+namespace {
 
-    // TODO: reuse z_streams
-    if (deflateInit(&deflate_stream, Z_DEFAULT_COMPRESSION) != Z_OK) {
-        throw std::runtime_error("failed to initialize deflate");
+// Setting up a z_stream allocates its window and tables, which costs more than compressing
+// most resources does. Each thread keeps one stream of each kind and resets it between uses.
+class Streams {
+public:
+    Streams() {
+        memset(&deflateStream, 0, sizeof(deflateStream));
+        memset(&inflateStream, 0, sizeof(inflateStream));
     }
 
-    deflate_stream.next_in = (Bytef *)raw.data();
-    deflate_stream.avail_in = uInt(raw.size());
+    ~Streams() {
+        if (deflateReady) {
+            deflateEnd(&deflateStream);
+        }
+        if (inflateReady) {
+            inflateEnd(&inflateStream);
+        }
+    }
 
-    std::string result;
-    char out[16384];
+    z_stream& deflater() {
+        if (!deflateReady) {
+            if (deflateInit(&deflateStream, Z_DEFAULT_COMPRESSION) != Z_OK) {
+                throw std::runtime_error("failed to initialize deflate");
+            }
+            deflateReady = true;
+        } else if (deflateReset(&deflateStream) != Z_OK) {
+            throw std::runtime_error("failed to reset deflate");
+        }
+        return deflateStream;
+    }
 
-    int code;
-    do {
-        deflate_stream.next_out = reinterpret_cast<Bytef *>(out);
-        deflate_stream.avail_out = sizeof(out);
-        code = deflate(&deflate_stream, Z_FINISH);
-        if (result.size() < deflate_stream.total_out) {
-            // append the block to the output string
-            result.append(out, deflate_stream.total_out - result.size());
+    z_stream& inflater() {
+        if (!inflateReady) {
+            if (inflateInit(&inflateStream) != Z_OK) {
+                throw std::runtime_error("failed to initialize inflate");
+            }
+            inflateReady = true;
+        } else if (inflateReset(&inflateStream) != Z_OK) {
+            throw std::runtime_error("failed to reset inflate");
         }
-    } while (code == Z_OK);
+        return inflateStream;
+    }
 
-    deflateEnd(&deflate_stream);
+private:
+    z_stream deflateStream;
+    z_stream inflateStream;
+    bool deflateReady = false;
+    bool inflateReady = false;
+};
+
+Streams& threadStreams() {
+    // Intentionally leaked: the streams of each thread are freed when the thread exits.
+    static auto streams = new util::ThreadLocal<Streams>;
+    Streams* result = streams->get();
+    if (!result) {
+        result = new Streams;
+        streams->set(result);
+    }
+    return *result;
+}
+
+} // namespace
+
+std::string compress(const std::string &raw) {
+    z_stream& stream = threadStreams().deflater();
+
+    // deflateBound() is an upper bound of the compressed size, so that a single call
+    // compresses all of the input.
+    std::string result(deflateBound(&stream, uLong(raw.size())), '\0');
 
+    stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(raw.data()));
+    stream.avail_in = uInt(raw.size());
+    stream.next_out = reinterpret_cast<Bytef *>(&result[0]);
+    stream.avail_out = uInt(result.size());
+
+    const int code = deflate(&stream, Z_FINISH);
     if (code != Z_STREAM_END) {
-        throw std::runtime_error(deflate_stream.msg);
+        throw std::runtime_error(stream.msg ? stream.msg : "compression error");
     }
 
+    result.resize(stream.total_out);
     return result;
 }
 
 std::string decompress(const std::string &raw) {
-    z_stream inflate_stream;
-    memset(&inflate_stream, 0, sizeof(inflate_stream));
-
-    // TODO: reuse z_streams
-    if (inflateInit(&inflate_stream) != Z_OK) {
-        throw std::runtime_error("failed to initialize inflate");
-    }
+    z_stream& stream = threadStreams().inflater();
 
-    inflate_stream.next_in = (Bytef *)raw.data();
-    inflate_stream.avail_in = uInt(raw.size());
+    stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(raw.data()));
+    stream.avail_in = uInt(raw.size());
 
-    std::string result;
-    char out[15384];
+    // The uncompressed size isn't stored in the stream: start from a typical compression
+    // ratio and double the output whenever it fills up.
+    std::string result(std::max<std::size_t>(raw.size() * 4, 1024), '\0');
 
     int code;
     do {
-        inflate_stream.next_out = reinterpret_cast<Bytef *>(out);
-        inflate_stream.avail_out = sizeof(out);
-        code = inflate(&inflate_stream, 0);
-        // result.append(out, sizeof(out) - inflate_stream.avail_out);
-        if (result.size() < inflate_stream.total_out) {
-            result.append(out, inflate_stream.total_out - result.size());
+        if (stream.total_out == result.size()) {
+            result.resize(result.size() * 2);
         }
+        stream.next_out = reinterpret_cast<Bytef *>(&result[stream.total_out]);
+        stream.avail_out = uInt(result.size() - stream.total_out);
+        code = inflate(&stream, Z_NO_FLUSH);
     } while (code == Z_OK);
 
-    inflateEnd(&inflate_stream);
-
     if (code != Z_STREAM_END) {
-        throw std::runtime_error(inflate_stream.msg ? inflate_stream.msg : "decompression error");
+        throw std::runtime_error(stream.msg ? stream.msg : "decompression error");
     }
 
+    result.resize(stream.total_out);
     return result;
 }
+
 } // namespace util
 } // namespace mbgl
@@ -0,0 +1,367 @@
+#include <mbgl/util/geobuf_reader.hpp>
+#include <mbgl/util/optional.hpp>
+#include <mbgl/util/rapidjson.hpp>
+
+#include <protozero/pbf_reader.hpp>
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace mbgl {
+namespace util {
+
+namespace {
+
+using Geometry = mapbox::geometry::geometry<double>;
+using CoordinateIterator = protozero::pbf_reader::const_sint64_iterator;
+
+// Properties that aren't strings, numbers or booleans are stored as JSON.
+Value toValue(const JSValue& value) {
+    switch (value.GetType()) {
+    case rapidjson::kNullType:
+        return NullValue();
+    case rapidjson::kFalseType:
+        return false;
+    case rapidjson::kTrueType:
+        return true;
+    case rapidjson::kStringType:
+        return std::string(value.GetString(), value.GetStringLength());
+    case rapidjson::kNumberType:
+        if (value.IsUint64()) return value.GetUint64();
+        if (value.IsInt64()) return value.GetInt64();
+        return value.GetDouble();
+    case rapidjson::kArrayType: {
+        std::vector<Value> result;
+        result.reserve(value.Size());
+        for (const auto& element : value.GetArray()) {
+            result.push_back(toValue(element));
+        }
+        return result;
+    }
+    case rapidjson::kObjectType: {
+        PropertyMap result;
+        for (const auto& member : value.GetObject()) {
+            result.emplace(std::string(member.name.GetString(), member.name.GetStringLength()),
+                           toValue(member.value));
+        }
+        return result;
+    }
+    }
+    return NullValue();
+}
+
+class Decoder {
+public:
+    explicit Decoder(const std::string& data_) : data(data_) {
+        protozero::pbf_reader pbf(data);
+        while (pbf.next()) {
+            switch (pbf.tag()) {
+            case 1: // keys
+                keys.push_back(pbf.get_string());
+                break;
+            case 2: // dimensions
+                dimensions = pbf.get_uint32();
+                break;
+            case 3: // precision
+                scale = std::pow(10.0, pbf.get_uint32());
+                break;
+            default:
+                pbf.skip();
+                break;
+            }
+        }
+
+        if (dimensions < 2) {
+            throw std::runtime_error("Geobuf coordinates must have at least two dimensions");
+        }
+    }
+
+    GeoJSON decode(const std::function<void (Feature&&)>* onFeature) {
+        protozero::pbf_reader pbf(data);
+        while (pbf.next()) {
+            switch (pbf.tag()) {
+            case 4: { // feature_collection
+                mapbox::geometry::feature_collection<double> features;
+                protozero::pbf_reader collection = pbf.get_message();
+                while (collection.next(1)) { // features
+                    if (onFeature) {
+                        (*onFeature)(feature(collection.get_message()));
+                    } else {
+                        features.push_back(feature(collection.get_message()));
+                    }
+                }
+                return GeoJSON(std::move(features));
+            }
+            case 5: // feature
+                return GeoJSON(feature(pbf.get_message()));
+            case 6: // geometry
+                return GeoJSON(geometry(pbf.get_message()));
+            default:
+                pbf.skip();
+                break;
+            }
+        }
+
+        throw std::runtime_error("Geobuf data must contain a feature collection, a feature or a geometry");
+    }
+
+private:
+    Feature feature(protozero::pbf_reader pbf) {
+        optional<Geometry> featureGeometry;
+        optional<FeatureIdentifier> id;
+        std::vector<Value> values;
+        protozero::iterator_range<protozero::pbf_reader::const_uint32_iterator> properties;
+
+        while (pbf.next()) {
+            switch (pbf.tag()) {
+            case 1: // geometry
+                featureGeometry = geometry(pbf.get_message());
+                break;
+            case 11: // id
+                id = FeatureIdentifier(pbf.get_string());
+                break;
+            case 12: { // int_id
+                const int64_t intID = pbf.get_sint64();
+                id = intID < 0 ? FeatureIdentifier(intID) : FeatureIdentifier(uint64_t(intID));
+                break;
+            }
+            case 13: // values
+                values.push_back(value(pbf.get_message()));
+                break;
+            case 14: // properties
+                properties = pbf.get_packed_uint32();
+                break;
+            default:
+                pbf.skip();
+                break;
+            }
+        }
+
+        // Pairs of indices into the keys and the values.
+        PropertyMap propertyMap;
+        for (auto it = properties.begin(); it != properties.end();) {
+            const uint32_t keyIndex = *it;
+            if (++it == properties.end()) {
+                throw std::runtime_error("Geobuf feature properties must be pairs of indices");
+            }
+            const uint32_t valueIndex = *it;
+            ++it;
+            if (keyIndex >= keys.size() || valueIndex >= values.size()) {
+                throw std::runtime_error("Geobuf feature property index out of range");
+            }
+            propertyMap[keys[keyIndex]] = values[valueIndex];
+        }
+
+        // A feature without a geometry is given an empty one.
+        return Feature {
+            featureGeometry ? std::move(*featureGeometry)
+                            : Geometry(mapbox::geometry::geometry_collection<double>()),
+            std::move(propertyMap),
+            std::move(id)
+        };
+    }
+
+    Value value(protozero::pbf_reader pbf) {
+        while (pbf.next()) {
+            switch (pbf.tag()) {
+            case 1: // string_value
+                return pbf.get_string();
+            case 2: // double_value
+                return pbf.get_double();
+            case 3: // pos_int_value
+                return pbf.get_uint64();
+            case 4: // neg_int_value
+                return -static_cast<int64_t>(pbf.get_uint64());
+            case 5: // bool_value
+                return pbf.get_bool();
+            case 6: { // json_value
+                const std::string json = pbf.get_string();
+                JSDocument document;
+                document.Parse<0>(json.c_str());
+                if (document.HasParseError()) {
+                    throw std::runtime_error("Geobuf value contains invalid JSON");
+                }
+                return toValue(document);
+            }
+            default:
+                pbf.skip();
+                break;
+            }
+        }
+        return NullValue();
+    }
+
+    Geometry geometry(protozero::pbf_reader pbf) {
+        int32_t type = 0;
+        std::vector<uint32_t> lengths;
+        protozero::iterator_range<CoordinateIterator> coordinates;
+        mapbox::geometry::geometry_collection<double> geometries;
+
+        while (pbf.next()) {
+            switch (pbf.tag()) {
+            case 1: // type
+                type = pbf.get_enum();
+                break;
+            case 2: { // lengths
+                const auto range = pbf.get_packed_uint32();
+                lengths.assign(range.begin(), range.end());
+                break;
+            }
+            case 3: // coords
+                coordinates = pbf.get_packed_sint64();
+                break;
+            case 4: // geometries
+                geometries.push_back(geometry(pbf.get_message()));
+                break;
+            default:
+                pbf.skip();
+                break;
+            }
+        }
+
+        auto it = coordinates.begin();
+        const auto end = coordinates.end();
+
+        switch (type) {
+        case 0: { // POINT
+            if (it == end) {
+                throw std::runtime_error("Geobuf point must have coordinates");
+            }
+            mapbox::geometry::point<double> point = position(it, end);
+            return Geometry(point);
+        }
+        case 1: // MULTIPOINT
+            return Geometry(line<mapbox::geometry::multi_point<double>>(it, end, all, false));
+        case 2: // LINESTRING
+            return Geometry(line<mapbox::geometry::line_string<double>>(it, end, all, false));
+        case 3: // MULTILINESTRING
+            return Geometry(lines<mapbox::geometry::multi_line_string<double>>(it, end, lengths, false));
+        case 4: // POLYGON
+            return Geometry(lines<mapbox::geometry::polygon<double>>(it, end, lengths, true));
+        case 5: { // MULTIPOLYGON
+            mapbox::geometry::multi_polygon<double> polygons;
+            if (lengths.empty()) {
+                polygons.push_back(lines<mapbox::geometry::polygon<double>>(it, end, lengths, true));
+                return Geometry(std::move(polygons));
+            }
+
+            // The number of polygons, then for each the number of rings followed by the
+            // length of each ring.
+            std::size_t i = 1;
+            for (uint32_t p = 0; p < lengths[0]; ++p) {
+                if (i >= lengths.size() || i + lengths[i] >= lengths.size()) {
+                    throw std::runtime_error("Geobuf multipolygon lengths are inconsistent");
+                }
+                mapbox::geometry::polygon<double> polygon;
+                for (uint32_t r = 0; r < lengths[i]; ++r) {
+                    polygon.push_back(line<mapbox::geometry::linear_ring<double>>(it, end, lengths[i + 1 + r], true));
+                }
+                i += lengths[i] + 1;
+                polygons.push_back(std::move(polygon));
+            }
+            return Geometry(std::move(polygons));
+        }
+        case 6: // GEOMETRYCOLLECTION
+            return Geometry(std::move(geometries));
+        default:
+            throw std::runtime_error("unknown Geobuf geometry type");
+        }
+    }
+
+    static constexpr std::size_t all = std::numeric_limits<std::size_t>::max();
+
+    mapbox::geometry::point<double> position(CoordinateIterator& it, const CoordinateIterator& end) {
+        mapbox::geometry::point<double> point;
+        point.x = *it / scale;
+        ++it;
+        point.y = *it / scale;
+        ++it;
+        skipDimensions(it, end);
+        return point;
+    }
+
+    // Reads `count` (or all remaining) delta-encoded positions. Geobuf leaves out the last
+    // position of a ring, as it repeats the first.
+    template <class T>
+    T line(CoordinateIterator& it, const CoordinateIterator& end, std::size_t count, bool closed) {
+        T result;
+        if (count != all) {
+            result.reserve(count + closed);
+        }
+
+        int64_t x = 0;
+        int64_t y = 0;
+        for (std::size_t i = 0; i < count && it != end; ++i) {
+            x += *it;
+            ++it;
+            y += *it;
+            ++it;
+            skipDimensions(it, end);
+            result.emplace_back(x / scale, y / scale);
+        }
+
+        if (count != all && result.size() != count) {
+            throw std::runtime_error("Geobuf geometry has fewer coordinates than its lengths");
+        }
+
+        if (closed && !result.empty()) {
+            result.push_back(result.front());
+        }
+        return result;
+    }
+
+    // The lines of a MultiLineString or the rings of a Polygon; a single line if there are
+    // no lengths.
+    template <class T>
+    T lines(CoordinateIterator& it, const CoordinateIterator& end,
+            const std::vector<uint32_t>& lengths, bool closed) {
+        using Line = typename T::value_type;
+        T result;
+        if (lengths.empty()) {
+            result.push_back(line<Line>(it, end, all, closed));
+        } else {
+            for (const uint32_t length : lengths) {
+                result.push_back(line<Line>(it, end, length, closed));
+            }
+        }
+        return result;
+    }
+
+    void skipDimensions(CoordinateIterator& it, const CoordinateIterator& end) {
+        for (uint32_t d = 2; d < dimensions && it != end; ++d) {
+            ++it;
+        }
+    }
+
+    const std::string& data;
+    std::vector<std::string> keys;
+    uint32_t dimensions = 2;
+    double scale = 1e6;
+};
+
+} // namespace
+
+GeoJSON parseGeobuf(const std::string& data) {
+    return Decoder(data).decode(nullptr);
+}
+
+void parseGeobufFeatures(const std::string& data, const std::function<void (Feature&&)>& onFeature) {
+    GeoJSON geoJSON = Decoder(data).decode(&onFeature);
+
+    if (geoJSON.is<Feature>()) {
+        onFeature(std::move(geoJSON.get<Feature>()));
+    } else if (geoJSON.is<Geometry>()) {
+        onFeature(Feature { std::move(geoJSON.get<Geometry>()) });
+    }
+}
+
+bool isGeobuf(const std::string& data) {
+    const auto first = data.find_first_not_of(" \t\n\r");
+    return first != std::string::npos && data[first] != '{';
+}
+
+} // namespace util
+} // namespace mbgl
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <mbgl/util/feature.hpp>
+#include <mbgl/util/geojson.hpp>
+
+#include <functional>
+#include <string>
+
+namespace mbgl {
+namespace util {
+
+/*
+   Decodes Geobuf, a compact protocol buffers encoding of GeoJSON, directly into geometries
+   and features. See https://github.com/mapbox/geobuf.
+
+   Both functions throw a std::exception for malformed data.
+*/
+GeoJSON parseGeobuf(const std::string&);
+
+// Passes each feature of a FeatureCollection to `onFeature` as soon as it is decoded,
+// without collecting them. A lone Feature or geometry is passed as a single feature.
+void parseGeobufFeatures(const std::string&, const std::function<void (Feature&&)>& onFeature);
+
+// Whether `data` is Geobuf rather than GeoJSON text, which starts with '{' after any
+// whitespace. Geobuf starts with a protocol buffers field key and is unlikely to look like that.
+bool isGeobuf(const std::string& data);
+
+} // namespace util
+} // namespace mbgl
@@ -0,0 +1,529 @@
+#include <mbgl/util/geojson_reader.hpp>
+#include <mbgl/util/optional.hpp>
+
+#include <rapidjson/reader.h>
+#include <rapidjson/error/en.h>
+
+#include <array>
+#include <cassert>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace mbgl {
+namespace util {
+
+namespace {
+
+using Point = mapbox::geometry::point<double>;
+using Geometry = mapbox::geometry::geometry<double>;
+
+// The nested "coordinates" arrays of a geometry, flattened into a list of positions and,
+// for each depth of nesting, the number of elements read by the end of each array.
+class Coordinates {
+public:
+    bool active() const {
+        return depth > 0;
+    }
+
+    void startArray() {
+        if (depth == 0) {
+            // A repeated "coordinates" member replaces the previous one.
+            points.clear();
+            for (auto& end : ends) {
+                end.clear();
+            }
+            leafDepth = 0;
+            present = true;
+        }
+        if (++depth > 4) {
+            throw std::runtime_error("coordinates are nested too deeply");
+        }
+        size = 0;
+    }
+
+    void number(double n) {
+        if (!leafDepth) {
+            leafDepth = depth;
+        } else if (depth != leafDepth) {
+            throw std::runtime_error("coordinates are nested inconsistently");
+        }
+
+        if (size == 0) {
+            x = n;
+        } else if (size == 1) {
+            y = n;
+        }
+        ++size;
+    }
+
+    void endArray() {
+        if (depth == leafDepth) {
+            if (size < 2) {
+                throw std::runtime_error("a position must have at least two elements");
+            }
+            points.emplace_back(x, y);
+        } else {
+            ends[depth].push_back(depth + 1 == leafDepth ? points.size() : ends[depth + 1].size());
+        }
+        --depth;
+    }
+
+    Geometry geometry(const std::string& type) const {
+        if (type == "Point") {
+            expectDepth(type, 1);
+            if (points.empty()) {
+                throw std::runtime_error("Point must have a position");
+            }
+            return Geometry(points.front());
+        } else if (type == "MultiPoint") {
+            expectDepth(type, 2);
+            return Geometry(mapbox::geometry::multi_point<double>(points.begin(), points.end()));
+        } else if (type == "LineString") {
+            expectDepth(type, 2);
+            return Geometry(mapbox::geometry::line_string<double>(points.begin(), points.end()));
+        } else if (type == "MultiLineString") {
+            expectDepth(type, 3);
+            return Geometry(lines<mapbox::geometry::multi_line_string<double>>(0, ends[2].size(), 2));
+        } else if (type == "Polygon") {
+            expectDepth(type, 3);
+            return Geometry(lines<mapbox::geometry::polygon<double>>(0, ends[2].size(), 2));
+        } else if (type == "MultiPolygon") {
+            expectDepth(type, 4);
+            mapbox::geometry::multi_polygon<double> polygons;
+            std::size_t first = 0;
+            for (const std::size_t last : ends[2]) {
+                polygons.push_back(lines<mapbox::geometry::polygon<double>>(first, last, 3));
+                first = last;
+            }
+            return Geometry(std::move(polygons));
+        } else {
+            throw std::runtime_error("unknown geometry type \"" + type + "\"");
+        }
+    }
+
+private:
+    void expectDepth(const std::string& type, std::size_t expected) const {
+        if (!present) {
+            throw std::runtime_error(type + " must have coordinates");
+        }
+        if (leafDepth && leafDepth != expected) {
+            throw std::runtime_error(type + " coordinates are nested incorrectly");
+        }
+    }
+
+    // The arrays [first, last) at depth `lineDepth` -- the lines of a MultiLineString or the
+    // rings of a Polygon.
+    template <class T>
+    T lines(std::size_t first, std::size_t last, std::size_t lineDepth) const {
+        T result;
+        for (std::size_t i = first; i < last; ++i) {
+            const std::size_t begin = i == 0 ? 0 : ends[lineDepth][i - 1];
+            result.emplace_back(points.begin() + begin, points.begin() + ends[lineDepth][i]);
+        }
+        return result;
+    }
+
+    std::vector<Point> points;
+    std::array<std::vector<std::size_t>, 6> ends;
+
+    bool present = false;
+    std::size_t depth = 0;
+    std::size_t leafDepth = 0;
+
+    // The position being read.
+    std::size_t size = 0;
+    double x = 0;
+    double y = 0;
+};
+
+enum class Member {
+    Other,
+    Type,
+    Coordinates,
+    Geometry,
+    Geometries,
+    Features,
+    Properties,
+    ID
+};
+
+Member memberNamed(const char* name, std::size_t length) {
+    auto is = [&] (const char* candidate) {
+        return std::strlen(candidate) == length && std::memcmp(candidate, name, length) == 0;
+    };
+
+    if (is("type")) return Member::Type;
+    if (is("coordinates")) return Member::Coordinates;
+    if (is("geometry")) return Member::Geometry;
+    if (is("geometries")) return Member::Geometries;
+    if (is("features")) return Member::Features;
+    if (is("properties")) return Member::Properties;
+    if (is("id")) return Member::ID;
+    return Member::Other;
+}
+
+// A GeoJSON object being read: a geometry, a feature or a feature collection. Its members
+// may come in any order, so it isn't converted until it ends.
+class Object {
+public:
+    Member member = Member::Other; // The member being read.
+    bool inArray = false;          // Whether the array value of `member` is being read.
+
+    std::string type;
+    Coordinates coordinates;
+    optional<Geometry> geometry;
+    mapbox::geometry::geometry_collection<double> geometries;
+    mapbox::geometry::feature_collection<double> features;
+    PropertyMap properties;
+    optional<FeatureIdentifier> id;
+
+    // The number of features passed on as they were read rather than collected.
+    std::size_t passedOn = 0;
+};
+
+Geometry toGeometry(Object& object) {
+    if (object.type == "GeometryCollection") {
+        return Geometry(std::move(object.geometries));
+    } else if (object.type.empty()) {
+        throw std::runtime_error("GeoJSON object must have a type");
+    } else if (object.type == "Feature" || object.type == "FeatureCollection") {
+        throw std::runtime_error("expected a geometry, found a " + object.type);
+    } else {
+        return object.coordinates.geometry(object.type);
+    }
+}
+
+Feature toFeature(Object& object) {
+    if (object.type != "Feature") {
+        throw std::runtime_error("features must be Feature objects");
+    }
+
+    // A feature without a geometry is given an empty one.
+    return Feature {
+        object.geometry ? std::move(*object.geometry)
+                        : Geometry(mapbox::geometry::geometry_collection<double>()),
+        std::move(object.properties),
+        std::move(object.id)
+    };
+}
+
+// Receives the events of rapidjson's SAX reader. GeoJSON objects are kept on one stack;
+// property values and foreign members, which may be any JSON value, on another.
+class Handler : public rapidjson::BaseReaderHandler<rapidjson::UTF8<>, Handler> {
+public:
+    explicit Handler(const std::function<void (Feature&&)>* onFeature_)
+        : onFeature(onFeature_) {
+    }
+
+    GeoJSON takeResult() {
+        assert(result);
+        return std::move(*result);
+    }
+
+    bool Null() {
+        return addValue(Value(NullValue()));
+    }
+
+    bool Bool(bool b) {
+        return addValue(Value(b));
+    }
+
+    bool Int(int i) {
+        return Int64(i);
+    }
+
+    bool Uint(unsigned i) {
+        return Uint64(i);
+    }
+
+    bool Int64(int64_t i) {
+        if (inCoordinates()) {
+            objects.back().coordinates.number(i);
+            return true;
+        }
+        return addValue(i < 0 ? Value(i) : Value(uint64_t(i)));
+    }
+
+    bool Uint64(uint64_t i) {
+        if (inCoordinates()) {
+            objects.back().coordinates.number(i);
+            return true;
+        }
+        return addValue(Value(i));
+    }
+
+    bool Double(double d) {
+        if (inCoordinates()) {
+            objects.back().coordinates.number(d);
+            return true;
+        }
+        return addValue(Value(d));
+    }
+
+    bool String(const char* string, rapidjson::SizeType length, bool) {
+        return addValue(Value(std::string(string, length)));
+    }
+
+    bool StartObject() {
+        if (values.empty()) {
+            if (objects.empty()) {
+                objects.emplace_back();
+                return true;
+            }
+
+            const Object& object = objects.back();
+            if (object.coordinates.active()) {
+                throw std::runtime_error("coordinates must be numbers");
+            }
+
+            switch (object.member) {
+            case Member::Geometry:
+                objects.emplace_back();
+                return true;
+            case Member::Geometries:
+            case Member::Features:
+                if (!object.inArray) {
+                    throw std::runtime_error("geometries and features must be arrays");
+                }
+                objects.emplace_back();
+                return true;
+            case Member::Type:
+            case Member::ID:
+            case Member::Coordinates:
+                throw std::runtime_error("unexpected object");
+            case Member::Properties:
+            case Member::Other:
+                break;
+            }
+        }
+
+        values.emplace_back(Value(PropertyMap()), std::string());
+        return true;
+    }
+
+    bool Key(const char* string, rapidjson::SizeType length, bool) {
+        if (!values.empty()) {
+            values.back().second.assign(string, length);
+        } else {
+            objects.back().member = memberNamed(string, length);
+            objects.back().inArray = false;
+        }
+        return true;
+    }
+
+    bool EndObject(rapidjson::SizeType) {
+        if (!values.empty()) {
+            return endValue();
+        }
+
+        Object object = std::move(objects.back());
+        objects.pop_back();
+
+        if (objects.empty()) {
+            finish(object);
+            return true;
+        }
+
+        Object& parent = objects.back();
+        switch (parent.member) {
+        case Member::Geometry:
+            parent.geometry = toGeometry(object);
+            break;
+        case Member::Geometries:
+            parent.geometries.push_back(toGeometry(object));
+            break;
+        case Member::Features:
+            if (onFeature && objects.size() == 1) {
+                (*onFeature)(toFeature(object));
+                ++parent.passedOn;
+            } else {
+                parent.features.push_back(toFeature(object));
+            }
+            break;
+        default:
+            assert(false);
+            break;
+        }
+        return true;
+    }
+
+    bool StartArray() {
+        if (values.empty()) {
+            if (objects.empty()) {
+                throw std::runtime_error("GeoJSON must be an object");
+            }
+
+            Object& object = objects.back();
+            if (object.coordinates.active() || object.member == Member::Coordinates) {
+                object.coordinates.startArray();
+                return true;
+            }
+
+            switch (object.member) {
+            case Member::Geometries:
+            case Member::Features:
+                if (object.inArray) {
+                    throw std::runtime_error("geometries and features must contain objects");
+                }
+                object.inArray = true;
+                return true;
+            case Member::Type:
+            case Member::ID:
+            case Member::Geometry:
+                throw std::runtime_error("unexpected array");
+            case Member::Coordinates:
+            case Member::Properties:
+            case Member::Other:
+                break;
+            }
+        }
+
+        values.emplace_back(Value(std::vector<Value>()), std::string());
+        return true;
+    }
+
+    bool EndArray(rapidjson::SizeType) {
+        if (!values.empty()) {
+            return endValue();
+        }
+
+        Object& object = objects.back();
+        if (object.coordinates.active()) {
+            object.coordinates.endArray();
+        } else {
+            object.inArray = false;
+        }
+        return true;
+    }
+
+private:
+    bool inCoordinates() const {
+        return values.empty() && !objects.empty() && objects.back().coordinates.active();
+    }
+
+    bool endValue() {
+        Value value = std::move(values.back().first);
+        values.pop_back();
+        return addValue(std::move(value));
+    }
+
+    // Adds a complete value to the array or object being read, or to the member of the
+    // GeoJSON object it is the value of.
+    bool addValue(Value value) {
+        if (!values.empty()) {
+            auto& parent = values.back();
+            if (parent.first.is<std::vector<Value>>()) {
+                parent.first.get<std::vector<Value>>().push_back(std::move(value));
+            } else {
+                parent.first.get<PropertyMap>()[std::move(parent.second)] = std::move(value);
+            }
+            return true;
+        }
+
+        if (objects.empty()) {
+            throw std::runtime_error("GeoJSON must be an object");
+        }
+
+        Object& object = objects.back();
+        if (object.coordinates.active()) {
+            throw std::runtime_error("coordinates must be numbers");
+        }
+
+        switch (object.member) {
+        case Member::Type:
+            if (!value.is<std::string>()) {
+                throw std::runtime_error("type must be a string");
+            }
+            object.type = std::move(value.get<std::string>());
+            break;
+        case Member::ID:
+            if (value.is<uint64_t>()) {
+                object.id = FeatureIdentifier(value.get<uint64_t>());
+            } else if (value.is<int64_t>()) {
+                object.id = FeatureIdentifier(value.get<int64_t>());
+            } else if (value.is<double>()) {
+                object.id = FeatureIdentifier(value.get<double>());
+            } else if (value.is<std::string>()) {
+                object.id = FeatureIdentifier(std::move(value.get<std::string>()));
+            } else if (!value.is<NullValue>()) {
+                throw std::runtime_error("id must be a number or a string");
+            }
+            break;
+        case Member::Properties:
+            if (value.is<PropertyMap>()) {
+                object.properties = std::move(value.get<PropertyMap>());
+            } else if (!value.is<NullValue>()) {
+                throw std::runtime_error("properties must be an object");
+            }
+            break;
+        case Member::Geometry:
+            if (!value.is<NullValue>()) {
+                throw std::runtime_error("geometry must be an object");
+            }
+            break;
+        case Member::Coordinates:
+        case Member::Geometries:
+        case Member::Features:
+            throw std::runtime_error("coordinates, geometries and features must be arrays");
+        case Member::Other:
+            break; // Foreign members are ignored.
+        }
+        return true;
+    }
+
+    void finish(Object& root) {
+        if (root.type == "FeatureCollection") {
+            result = GeoJSON(std::move(root.features));
+        } else if (root.passedOn) {
+            throw std::runtime_error("only a FeatureCollection may have features");
+        } else if (root.type == "Feature") {
+            result = GeoJSON(toFeature(root));
+        } else {
+            result = GeoJSON(toGeometry(root));
+        }
+    }
+
+    const std::function<void (Feature&&)>* onFeature;
+
+    std::vector<Object> objects;
+    std::vector<std::pair<Value, std::string>> values; // With the key of the next member.
+
+    optional<GeoJSON> result;
+};
+
+GeoJSON parse(const std::string& json, const std::function<void (Feature&&)>* onFeature) {
+    Handler handler(onFeature);
+    rapidjson::Reader reader;
+    rapidjson::StringStream stream(json.c_str());
+
+    if (!reader.Parse(stream, handler)) {
+        std::stringstream message;
+        message << reader.GetErrorOffset() << " - "
+                << rapidjson::GetParseError_En(reader.GetParseErrorCode());
+        throw std::runtime_error(message.str());
+    }
+
+    return handler.takeResult();
+}
+
+} // namespace
+
+GeoJSON parseGeoJSON(const std::string& json) {
+    return parse(json, nullptr);
+}
+
+void parseGeoJSONFeatures(const std::string& json, const std::function<void (Feature&&)>& onFeature) {
+    GeoJSON geoJSON = parse(json, &onFeature);
+
+    if (geoJSON.is<Feature>()) {
+        onFeature(std::move(geoJSON.get<Feature>()));
+    } else if (geoJSON.is<Geometry>()) {
+        onFeature(Feature { std::move(geoJSON.get<Geometry>()) });
+    }
+}
+
+} // namespace util
+} // namespace mbgl
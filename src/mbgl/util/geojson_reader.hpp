@@ -0,0 +1,25 @@
+#pragma once
+
+#include <mbgl/util/feature.hpp>
+#include <mbgl/util/geojson.hpp>
+
+#include <functional>
+#include <string>
+
+namespace mbgl {
+namespace util {
+
+/*
+   Parses GeoJSON text with a streaming (SAX) JSON reader, building geometries and
+   features while the text is read instead of parsing it into a JSON document first.
+
+   Both functions throw std::runtime_error for malformed JSON or GeoJSON.
+*/
+GeoJSON parseGeoJSON(const std::string&);
+
+// Passes each feature of a FeatureCollection to `onFeature` as soon as it is read, without
+// collecting them. A lone Feature or geometry is passed as a single feature.
+void parseGeoJSONFeatures(const std::string&, const std::function<void (Feature&&)>& onFeature);
+
+} // namespace util
+} // namespace mbgl
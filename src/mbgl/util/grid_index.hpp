@@ -19,6 +19,9 @@ public:
     void insert(T&& t, const BBox&);
     std::vector<T> query(const BBox&) const;
 
+    // The memory used by the index itself, not counting memory owned by the elements.
+    std::size_t bytes() const;
+
 private:
     int32_t convertToCellCoord(int32_t x) const;
 
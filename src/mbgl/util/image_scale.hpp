@@ -0,0 +1,37 @@
+#pragma once
+
+#include <mbgl/util/size.hpp>
+
+#include <cstdint>
+
+namespace mbgl {
+namespace util {
+
+// libjpeg's DCT scaling reduces images by 1/2, 1/4 or 1/8. Scaled WebP decoding uses the
+// same factors, so that both formats decode to the same sizes.
+constexpr uint32_t maxScaleDenominator = 8;
+
+// The largest power of two, up to `maxScaleDenominator`, by which an image of `size` can
+// be reduced while staying at least as large as `target`, which must be the largest size
+// the image is drawn at. The reduced size is rounded up, like libjpeg does. An empty
+// target always decodes at full resolution.
+inline uint32_t scaleDenominator(const Size& size, const Size& target) {
+    uint32_t denominator = 1;
+    if (!target) {
+        return denominator;
+    }
+
+    while (denominator < maxScaleDenominator) {
+        const uint32_t next = denominator * 2;
+        if ((size.width + next - 1) / next < target.width ||
+            (size.height + next - 1) / next < target.height) {
+            break;
+        }
+        denominator = next;
+    }
+
+    return denominator;
+}
+
+} // namespace util
+} // namespace mbgl
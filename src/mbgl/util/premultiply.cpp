@@ -2,17 +2,72 @@
 
 #include <cmath>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 namespace mbgl {
 namespace util {
 
-PremultipliedImage premultiply(UnassociatedImage&& src) {
-    PremultipliedImage dst;
+namespace {
 
-    dst.size = src.size;
-    dst.data = std::move(src.data);
+#if defined(__SSE2__)
+
+// Whether all four pixels are opaque. Opaque pixels are the same with either alpha mode.
+inline bool opaque(__m128i pixels) {
+    const __m128i alpha = _mm_set1_epi32(int(0xFF000000));
+    return _mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(pixels, alpha), alpha)) == 0xFFFF;
+}
+
+// (c * a + 127) / 255 for the colors of two pixels widened to 16 bits. With t = c * a + 128,
+// the division is (t + (t >> 8)) >> 8, which is exact over the whole range.
+inline __m128i premultiply16(__m128i pixels) {
+    __m128i alpha = _mm_shufflelo_epi16(pixels, _MM_SHUFFLE(3, 3, 3, 3));
+    alpha = _mm_shufflehi_epi16(alpha, _MM_SHUFFLE(3, 3, 3, 3));
+
+    const __m128i t = _mm_add_epi16(_mm_mullo_epi16(pixels, alpha), _mm_set1_epi16(128));
+    const __m128i colors = _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+
+    const __m128i alphaLanes = _mm_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0);
+    return _mm_or_si128(_mm_and_si128(alphaLanes, pixels), _mm_andnot_si128(alphaLanes, colors));
+}
+
+// (255 * c + a / 2) / a for the colors of one pixel widened to 32 bits, keeping the low
+// byte like the scalar code does. The numerator and the quotient are small enough that a
+// float division truncates to the exact integer result.
+inline __m128i unpremultiply32(__m128i pixel) {
+    const __m128i alpha = _mm_shuffle_epi32(pixel, _MM_SHUFFLE(3, 3, 3, 3));
+    const __m128i numerator = _mm_add_epi32(_mm_sub_epi32(_mm_slli_epi32(pixel, 8), pixel),
+                                            _mm_srli_epi32(alpha, 1));
+    const __m128 divisor = _mm_max_ps(_mm_cvtepi32_ps(alpha), _mm_set1_ps(1.0f));
+    const __m128i colors = _mm_and_si128(
+        _mm_cvttps_epi32(_mm_div_ps(_mm_cvtepi32_ps(numerator), divisor)), _mm_set1_epi32(0xFF));
 
-    uint8_t* data = dst.data.get();
-    for (size_t i = 0; i < dst.bytes(); i += 4) {
+    // Transparent pixels and the alpha channel are kept as they are.
+    const __m128i keep = _mm_or_si128(_mm_cmpeq_epi32(alpha, _mm_setzero_si128()),
+                                      _mm_set_epi32(-1, 0, 0, 0));
+    return _mm_or_si128(_mm_and_si128(keep, pixel), _mm_andnot_si128(keep, colors));
+}
+
+#endif // defined(__SSE2__)
+
+void premultiplyPixels(uint8_t* data, std::size_t bytes) {
+    std::size_t i = 0;
+
+#if defined(__SSE2__)
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 16 <= bytes; i += 16) {
+        __m128i* p = reinterpret_cast<__m128i*>(data + i);
+        const __m128i pixels = _mm_loadu_si128(p);
+        if (opaque(pixels)) {
+            continue;
+        }
+        _mm_storeu_si128(p, _mm_packus_epi16(premultiply16(_mm_unpacklo_epi8(pixels, zero)),
+                                             premultiply16(_mm_unpackhi_epi8(pixels, zero))));
+    }
+#endif
+
+    for (; i < bytes; i += 4) {
         uint8_t& r = data[i + 0];
         uint8_t& g = data[i + 1];
         uint8_t& b = data[i + 2];
@@ -21,18 +76,30 @@ PremultipliedImage premultiply(UnassociatedImage&& src) {
         g = (g * a + 127) / 255;
         b = (b * a + 127) / 255;
     }
-
-    return dst;
 }
 
-UnassociatedImage unpremultiply(PremultipliedImage&& src) {
-    UnassociatedImage dst;
+void unpremultiplyPixels(uint8_t* data, std::size_t bytes) {
+    std::size_t i = 0;
 
-    dst.size = src.size;
-    dst.data = std::move(src.data);
+#if defined(__SSE2__)
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 16 <= bytes; i += 16) {
+        __m128i* p = reinterpret_cast<__m128i*>(data + i);
+        const __m128i pixels = _mm_loadu_si128(p);
+        if (opaque(pixels)) {
+            continue;
+        }
+        const __m128i lo = _mm_unpacklo_epi8(pixels, zero);
+        const __m128i hi = _mm_unpackhi_epi8(pixels, zero);
+        const __m128i lo32 = _mm_packs_epi32(unpremultiply32(_mm_unpacklo_epi16(lo, zero)),
+                                             unpremultiply32(_mm_unpackhi_epi16(lo, zero)));
+        const __m128i hi32 = _mm_packs_epi32(unpremultiply32(_mm_unpacklo_epi16(hi, zero)),
+                                             unpremultiply32(_mm_unpackhi_epi16(hi, zero)));
+        _mm_storeu_si128(p, _mm_packus_epi16(lo32, hi32));
+    }
+#endif
 
-    uint8_t* data = dst.data.get();
-    for (size_t i = 0; i < dst.bytes(); i += 4) {
+    for (; i < bytes; i += 4) {
         uint8_t& r = data[i + 0];
         uint8_t& g = data[i + 1];
         uint8_t& b = data[i + 2];
@@ -43,6 +110,28 @@ UnassociatedImage unpremultiply(PremultipliedImage&& src) {
             b = (255 * b + (a / 2)) / a;
         }
     }
+}
+
+} // namespace
+
+PremultipliedImage premultiply(UnassociatedImage&& src) {
+    PremultipliedImage dst;
+
+    dst.size = src.size;
+    dst.data = std::move(src.data);
+
+    premultiplyPixels(dst.data.get(), dst.bytes());
+
+    return dst;
+}
+
+UnassociatedImage unpremultiply(PremultipliedImage&& src) {
+    UnassociatedImage dst;
+
+    dst.size = src.size;
+    dst.data = std::move(src.data);
+
+    unpremultiplyPixels(dst.data.get(), dst.bytes());
 
     return dst;
 }
@@ -8,5 +8,16 @@ namespace util {
 PremultipliedImage premultiply(UnassociatedImage&&);
 UnassociatedImage unpremultiply(PremultipliedImage&&);
 
+// Gives a freshly decoded image the alpha mode `Mode`. Opaque images are the same in either
+// mode, so only translucent ones are premultiplied.
+template <ImageAlphaMode Mode>
+Image<Mode> withAlphaMode(UnassociatedImage&& image, bool opaque) {
+    if (Mode == ImageAlphaMode::Premultiplied && !opaque) {
+        PremultipliedImage premultiplied = premultiply(std::move(image));
+        return { premultiplied.size, std::move(premultiplied.data) };
+    }
+    return { image.size, std::move(image.data) };
+}
+
 } // namespace util
 } // namespace mbgl
@@ -6,6 +6,8 @@
 #include <chrono>
 #include <functional>
 #include <future>
+#include <thread>
+#include <vector>
 
 using namespace mbgl;
 using namespace std::chrono_literals;
@@ -137,3 +139,167 @@ TEST(Actor, NonConcurrentMailbox) {
     test.invoke(&Test::end);
     endedFuture.wait();
 }
+
+TEST(Actor, OrderedPerSender) {
+    // Messages from concurrent senders may interleave, but messages from each
+    // individual sender are received in the order sent.
+
+    struct Test {
+        std::vector<int> last;
+        std::atomic<int> remaining;
+        std::promise<void> promise;
+
+        Test(ActorRef<Test>, int senders, int count, std::promise<void> promise_)
+            : last(senders, 0),
+              remaining(senders * count),
+              promise(std::move(promise_)) {
+        }
+
+        void receive(int sender, int i) {
+            EXPECT_EQ(i, last[sender] + 1);
+            last[sender] = i;
+            if (--remaining == 0) {
+                promise.set_value();
+            }
+        }
+    };
+
+    ThreadPool pool { 2 };
+
+    const int senders = 4;
+    const int count = 1000;
+
+    std::promise<void> endedPromise;
+    std::future<void> endedFuture = endedPromise.get_future();
+    Actor<Test> test(pool, senders, count, std::move(endedPromise));
+
+    std::vector<std::thread> threads;
+    for (int sender = 0; sender < senders; ++sender) {
+        threads.emplace_back([&, sender] {
+            for (int i = 1; i <= count; ++i) {
+                test.invoke(&Test::receive, sender, i);
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    endedFuture.wait();
+}
+
+TEST(Actor, Priority) {
+    // Mailboxes with a higher priority are received first, including mailboxes whose
+    // priority is raised while they're already waiting to be received.
+
+    struct Test {
+        std::vector<int>& received;
+
+        Test(ActorRef<Test>, std::vector<int>& received_)
+            : received(received_) {
+        }
+
+        void block(std::shared_future<void> future) {
+            future.wait();
+        }
+
+        void receive(int i) {
+            received.push_back(i);
+        }
+    };
+
+    ThreadPool pool { 1 };
+
+    std::vector<int> received;
+    Actor<Test> blocker(pool, std::ref(received));
+    Actor<Test> low(pool, std::ref(received));
+    Actor<Test> high(pool, std::ref(received));
+    Actor<Test> raised(pool, std::ref(received));
+    low.setPriority(Scheduler::Priority::Low);
+    high.setPriority(Scheduler::Priority::High);
+    raised.setPriority(Scheduler::Priority::Low);
+
+    // Occupy the only thread so that the other mailboxes queue up behind it.
+    std::promise<void> unblock;
+    blocker.invoke(&Test::block, unblock.get_future().share());
+
+    low.invoke(&Test::receive, 1);
+    raised.invoke(&Test::receive, 2);
+    high.invoke(&Test::receive, 3);
+    raised.setPriority(Scheduler::Priority::High);
+
+    std::promise<void> endedPromise;
+    std::future<void> endedFuture = endedPromise.get_future();
+    unblock.set_value();
+
+    // Enqueued last with the lowest priority, so it completes last.
+    struct End {
+        End(ActorRef<End>) {}
+        void end(std::promise<void> promise) { promise.set_value(); }
+    };
+    Actor<End> end(pool);
+    end.setPriority(Scheduler::Priority::Low);
+    end.invoke(&End::end, std::move(endedPromise));
+    endedFuture.wait();
+
+    EXPECT_EQ((std::vector<int>{ 3, 2, 1 }), received);
+}
+
+TEST(Actor, ReceiveQuantum) {
+    // A thread receives up to the configured number of messages from a mailbox before
+    // moving on to the next one.
+
+    struct Test {
+        const int id;
+        std::vector<int>& received;
+
+        Test(ActorRef<Test>, int id_, std::vector<int>& received_)
+            : id(id_),
+              received(received_) {
+        }
+
+        void block(std::shared_future<void> future) {
+            future.wait();
+        }
+
+        void receive() {
+            received.push_back(id);
+        }
+
+        void end(std::promise<void> promise) {
+            promise.set_value();
+        }
+    };
+
+    auto run = [] (ReceiveQuantum quantum) {
+        ThreadPool pool { 1, quantum };
+
+        std::vector<int> received;
+        Actor<Test> blocker(pool, 0, std::ref(received));
+        Actor<Test> a(pool, 1, std::ref(received));
+        Actor<Test> b(pool, 2, std::ref(received));
+        Actor<Test> end(pool, 3, std::ref(received));
+        end.setPriority(Scheduler::Priority::Low);
+
+        std::promise<void> unblock;
+        blocker.invoke(&Test::block, unblock.get_future().share());
+
+        for (int i = 0; i < 4; ++i) {
+            a.invoke(&Test::receive);
+            b.invoke(&Test::receive);
+        }
+
+        std::promise<void> endedPromise;
+        std::future<void> endedFuture = endedPromise.get_future();
+        end.invoke(&Test::end, std::move(endedPromise));
+        unblock.set_value();
+        endedFuture.wait();
+
+        return received;
+    };
+
+    EXPECT_EQ((std::vector<int>{ 1, 2, 1, 2, 1, 2, 1, 2 }), run({}));
+    EXPECT_EQ((std::vector<int>{ 1, 1, 2, 2, 1, 1, 2, 2 }), run({ 2 }));
+    EXPECT_EQ((std::vector<int>{ 1, 1, 1, 1, 2, 2, 2, 2 }), run({ 10 }));
+}
@@ -0,0 +1,84 @@
+#include <mbgl/actor/actor.hpp>
+#include <mbgl/actor/instrumentation.hpp>
+#include <mbgl/util/default_thread_pool.hpp>
+
+#include <mbgl/test/util.hpp>
+
+#include <chrono>
+#include <future>
+#include <thread>
+
+using namespace mbgl;
+using namespace std::chrono_literals;
+
+namespace {
+
+class InstrumentedActor {
+public:
+    InstrumentedActor(ActorRef<InstrumentedActor>) {}
+
+    void block(std::promise<void> entered, std::shared_future<void> released) {
+        entered.set_value();
+        released.wait();
+    }
+
+    void receive() {
+        std::this_thread::sleep_for(1ms);
+    }
+
+    void end(std::promise<void> promise) {
+        promise.set_value();
+    }
+};
+
+} // namespace
+
+TEST(Instrumentation, Disabled) {
+    ThreadPool pool { 1 };
+    EXPECT_EQ(nullptr, pool.getInstrumentation());
+}
+
+TEST(Instrumentation, Snapshot) {
+    ThreadPool pool { 1 };
+    pool.enableInstrumentation();
+    ASSERT_NE(nullptr, pool.getInstrumentation());
+
+    {
+        Actor<InstrumentedActor> actor(pool);
+
+        // A message counts as queued until it has been processed, so while the actor is
+        // blocked, every message sent adds to the queue.
+        std::promise<void> entered;
+        std::future<void> enteredFuture = entered.get_future();
+        std::promise<void> released;
+        actor.invoke(&InstrumentedActor::block, std::move(entered), released.get_future().share());
+        enteredFuture.wait();
+
+        for (int i = 0; i < 10; ++i) {
+            actor.invoke(&InstrumentedActor::receive);
+        }
+
+        std::promise<void> promise;
+        std::future<void> future = promise.get_future();
+        actor.invoke(&InstrumentedActor::end, std::move(promise));
+
+        released.set_value();
+        future.wait();
+
+        // Destroying the actor waits for the last message to be fully processed.
+    }
+
+    const auto snapshot = pool.getInstrumentation()->snapshot();
+    ASSERT_EQ(1u, snapshot.size());
+
+    const auto& name = snapshot.begin()->first;
+    EXPECT_NE(std::string::npos, name.find("InstrumentedActor")) << name;
+
+    const actor::ActorStatistics& stats = snapshot.begin()->second;
+    EXPECT_EQ(12u, stats.messages);
+    EXPECT_EQ(12u, stats.executionTime.count);
+    EXPECT_EQ(12u, stats.waitTime.count);
+    EXPECT_EQ(12u, stats.maxQueueLength);
+    EXPECT_GE(stats.executionTime.max, std::chrono::duration_cast<Duration>(1ms));
+    EXPECT_GE(stats.executionTime.percentile(50), std::chrono::duration_cast<Duration>(1ms));
+}
@@ -0,0 +1,81 @@
+#include <mbgl/actor/actor.hpp>
+#include <mbgl/actor/message_pool.hpp>
+#include <mbgl/util/default_thread_pool.hpp>
+
+#include <mbgl/test/util.hpp>
+
+#include <future>
+
+using namespace mbgl;
+
+TEST(MessagePool, RecyclesMessages) {
+    // Messages that are sent from one thread and freed on another are recycled
+    // instead of being allocated from the heap every time.
+
+    struct Test {
+        Test(ActorRef<Test>) {}
+
+        void receive(std::promise<void> promise) {
+            promise.set_value();
+        }
+    };
+
+    ThreadPool pool { 1 };
+    Actor<Test> test(pool);
+
+    auto roundtrip = [&] {
+        std::promise<void> promise;
+        std::future<void> future = promise.get_future();
+        test.invoke(&Test::receive, std::move(promise));
+        future.wait();
+    };
+
+    // Warm up the pool of this thread.
+    for (int i = 0; i < 10; ++i) {
+        roundtrip();
+    }
+
+    const auto before = actor::messageAllocations();
+    for (int i = 0; i < 1000; ++i) {
+        roundtrip();
+    }
+    const auto after = actor::messageAllocations();
+
+    EXPECT_EQ(1000u, (after.heap - before.heap) + (after.pooled - before.pooled));
+    EXPECT_GT(10u, after.heap - before.heap);
+}
+
+TEST(MessagePool, LargeMessages) {
+    struct Large {
+        char data[1024];
+    };
+
+    struct Test {
+        std::promise<void> promise;
+
+        Test(ActorRef<Test>, std::promise<void> promise_)
+            : promise(std::move(promise_)) {
+        }
+
+        void receive(Large large) {
+            EXPECT_EQ('x', large.data[1023]);
+            promise.set_value();
+        }
+    };
+
+    ThreadPool pool { 1 };
+
+    std::promise<void> promise;
+    std::future<void> future = promise.get_future();
+    Actor<Test> test(pool, std::move(promise));
+
+    Large large;
+    large.data[1023] = 'x';
+
+    const auto before = actor::messageAllocations();
+    test.invoke(&Test::receive, large);
+    future.wait();
+    const auto after = actor::messageAllocations();
+
+    EXPECT_EQ(1u, after.heap - before.heap);
+}
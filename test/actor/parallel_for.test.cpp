@@ -0,0 +1,76 @@
+#include <mbgl/actor/actor.hpp>
+#include <mbgl/actor/parallel_for.hpp>
+#include <mbgl/util/default_thread_pool.hpp>
+
+#include <mbgl/test/util.hpp>
+
+#include <atomic>
+#include <future>
+#include <stdexcept>
+#include <vector>
+
+using namespace mbgl;
+
+TEST(ParallelFor, RunsEachTaskOnce) {
+    ThreadPool pool { 4 };
+
+    std::vector<std::atomic<int>> runs(1000);
+    for (auto& count : runs) {
+        count = 0;
+    }
+
+    parallelFor(pool, runs.size(), [&] (std::size_t i) {
+        runs[i]++;
+    });
+
+    for (const auto& count : runs) {
+        EXPECT_EQ(1, count.load());
+    }
+
+    parallelFor(pool, 0, [&] (std::size_t) {
+        FAIL();
+    });
+}
+
+TEST(ParallelFor, RethrowsFirstException) {
+    ThreadPool pool { 2 };
+
+    std::atomic<int> ran { 0 };
+    EXPECT_THROW(parallelFor(pool, 100, [&] (std::size_t i) {
+        ran++;
+        if (i % 10 == 0) {
+            throw std::runtime_error("task failed");
+        }
+    }), std::runtime_error);
+
+    // An exception doesn't stop the remaining tasks.
+    EXPECT_EQ(100, ran.load());
+}
+
+TEST(ParallelFor, FromActorOnSingleThreadedPool) {
+    // The actor occupies the only thread of the pool, so all tasks must run on it.
+
+    struct Test {
+        Test(ActorRef<Test>, Scheduler& scheduler_)
+            : scheduler(scheduler_) {
+        }
+
+        void run(std::promise<std::size_t> promise) {
+            std::size_t sum = 0;
+            parallelFor(scheduler, 10, [&] (std::size_t i) {
+                sum += i;
+            });
+            promise.set_value(sum);
+        }
+
+        Scheduler& scheduler;
+    };
+
+    ThreadPool pool { 1 };
+    Actor<Test> test(pool, pool);
+
+    std::promise<std::size_t> promise;
+    auto future = promise.get_future();
+    test.invoke(&Test::run, std::move(promise));
+    EXPECT_EQ(45u, future.get());
+}
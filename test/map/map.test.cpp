@@ -432,6 +432,75 @@ TEST(Map, DisabledSources) {
     test::checkImage("test/fixtures/map/disabled_layers/second", test::render(map, test.view));
 }
 
+TEST(Map, MemoryUsage) {
+    MapTest test;
+
+    test.fileSource.response = [] (const Resource& res) -> optional<Response> {
+        if (res.url == "asset://tile.png") {
+            Response response;
+            response.data = std::make_shared<std::string>(
+                util::read_file("test/fixtures/map/disabled_layers/tile.png"));
+            return {std::move(response)};
+        }
+        return {};
+    };
+
+    Map map(test.backend, test.view.getSize(), 1, test.fileSource, test.threadPool, MapMode::Still);
+    map.setZoom(1);
+
+    // Both raster layers use the same buckets.
+    map.setStyleJSON(R"STYLE(
+{
+  "version": 8,
+  "sources": {
+    "raster": {
+      "type": "raster",
+      "tiles": [ "asset://tile.png" ],
+      "tileSize": 256
+    }
+  },
+  "layers": [{
+    "id": "background",
+    "type": "background"
+  }, {
+    "id": "raster1",
+    "type": "raster",
+    "source": "raster"
+  }, {
+    "id": "raster2",
+    "type": "raster",
+    "source": "raster"
+  }]
+}
+)STYLE");
+
+    // Before the first render, there is no context state to report.
+    const MapMemoryUsage empty = map.getMemoryUsage();
+    EXPECT_EQ(0u, empty.bufferBytes);
+    EXPECT_EQ(0u, empty.textureBytes);
+
+    test::render(map, test.view);
+
+    const MapMemoryUsage usage = map.getMemoryUsage();
+    ASSERT_EQ(1u, usage.sources.count("raster"));
+    const MemoryUsage& source = usage.sources.at("raster");
+    EXPECT_LT(0u, source.cpu);
+    EXPECT_LT(0u, source.gpu);
+
+    ASSERT_EQ(2u, usage.layers.size());
+    EXPECT_EQ(source.cpu, usage.layers.at("raster1").cpu);
+    EXPECT_EQ(source.gpu, usage.layers.at("raster1").gpu);
+    EXPECT_EQ(source.cpu, usage.layers.at("raster2").cpu);
+    EXPECT_EQ(source.gpu, usage.layers.at("raster2").gpu);
+
+    const MemoryUsage atlases = usage.glyphAtlas + usage.spriteAtlas + usage.lineAtlas;
+    EXPECT_EQ(source.total() + atlases.total(), usage.total.total());
+
+    // The context also counts the renderer's own buffers and textures.
+    EXPECT_LT(0u, usage.bufferBytes);
+    EXPECT_LE(source.gpu, usage.textureBytes);
+}
+
 TEST(Map, Classes) {
     MapTest test;
 
@@ -2,6 +2,7 @@
 
 #include <mbgl/map/transform.hpp>
 #include <mbgl/util/geo.hpp>
+#include <mbgl/util/constants.hpp>
 
 using namespace mbgl;
 
@@ -504,6 +505,47 @@ TEST(Transform, Camera) {
     ASSERT_FALSE(transform.inTransition());
 }
 
+TEST(Transform, PrefetchStates) {
+    Transform transform;
+    transform.resize({ 1000, 1000 });
+    transform.setLatLngZoom({ 0, 0 }, 2);
+    EXPECT_TRUE(transform.getPrefetchStates().empty());
+
+    CameraOptions camera;
+    camera.center = LatLng { 45, 90 };
+    camera.zoom = 10;
+
+    transform.flyTo(camera, AnimationOptions(Seconds(1)));
+    std::vector<TransformState> states = transform.getPrefetchStates();
+    ASSERT_EQ(util::PREFETCH_SAMPLES, states.size());
+    EXPECT_NEAR(10, states.back().getZoom(), 0.00001);
+    EXPECT_NEAR(45, states.back().getLatLng().latitude, 0.001);
+    EXPECT_NEAR(90, states.back().getLatLng().longitude, 0.001);
+
+    // Sampling leaves the camera where it was.
+    EXPECT_DOUBLE_EQ(2, transform.getZoom());
+
+    // The camera no longer needs the states it has passed.
+    transform.updateTransitions(transform.getTransitionStart() + Milliseconds(500));
+    states = transform.getPrefetchStates();
+    ASSERT_FALSE(states.empty());
+    EXPECT_GT(util::PREFETCH_SAMPLES, states.size());
+    EXPECT_NEAR(10, states.back().getZoom(), 0.00001);
+
+    // Interrupting the animation stops prefetching.
+    transform.cancelTransitions();
+    EXPECT_TRUE(transform.getPrefetchStates().empty());
+
+    transform.easeTo(camera, AnimationOptions(Seconds(1)));
+    EXPECT_FALSE(transform.getPrefetchStates().empty());
+    transform.updateTransitions(transform.getTransitionStart() + transform.getTransitionDuration());
+    EXPECT_TRUE(transform.getPrefetchStates().empty());
+
+    // Camera changes without an animation have nothing to prefetch.
+    transform.jumpTo(camera);
+    EXPECT_TRUE(transform.getPrefetchStates().empty());
+}
+
 TEST(Transform, DefaultTransform) {
     Transform transform;
     const TransformState& state = transform.getState();
@@ -45,6 +45,7 @@ StubFileSource::StubFileSource() {
 StubFileSource::~StubFileSource() = default;
 
 std::unique_ptr<AsyncRequest> StubFileSource::request(const Resource& resource, Callback callback) {
+    requestedResources.push_back(resource);
     auto req = std::make_unique<StubFileRequest>(*this);
     pending.emplace(req.get(), std::make_tuple(resource, response, callback));
     return std::move(req);
@@ -57,6 +58,14 @@ void StubFileSource::remove(AsyncRequest* req) {
     }
 }
 
+std::vector<Resource> StubFileSource::pendingResources() const {
+    std::vector<Resource> result;
+    for (const auto& pair : pending) {
+        result.push_back(std::get<0>(pair.second));
+    }
+    return result;
+}
+
 optional<Response> StubFileSource::defaultResponse(const Resource& resource) {
     switch (resource.kind) {
     case Resource::Kind::Style:
@@ -4,6 +4,7 @@
 #include <mbgl/util/timer.hpp>
 
 #include <unordered_map>
+#include <vector>
 
 namespace mbgl {
 
@@ -30,6 +31,12 @@ public:
     ResponseFunction spriteJSONResponse;
     ResponseFunction spriteImageResponse;
 
+    // The requests that have neither been answered nor cancelled yet.
+    std::vector<Resource> pendingResources() const;
+
+    // Every request made so far, including those that have been answered or cancelled.
+    std::vector<Resource> requestedResources;
+
 private:
     // The default behavior is to throw if no per-kind callback has been set.
     optional<Response> defaultResponse(const Resource&);
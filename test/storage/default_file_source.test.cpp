@@ -1,6 +1,10 @@
 #include <mbgl/test/util.hpp>
 #include <mbgl/storage/default_file_source.hpp>
 #include <mbgl/util/run_loop.hpp>
+#include <mbgl/util/io.hpp>
+#include <mbgl/util/compression.hpp>
+
+#include <atomic>
 
 using namespace mbgl;
 
@@ -307,6 +311,121 @@ TEST(DefaultFileSource, OptionalNotFound) {
     loop.run();
 }
 
+// With a cache file, lookups go through the reader connection.
+TEST(DefaultFileSource, TEST_REQUIRES_WRITE(OptionalFromCacheFile)) {
+    util::RunLoop loop;
+    try {
+        util::deleteFile("test/fixtures/storage/cache.db");
+    } catch (const util::IOException&) {
+    }
+    DefaultFileSource fs("test/fixtures/storage/cache.db", ".");
+
+    const Resource cachedResource { Resource::Unknown, "http://127.0.0.1:3000/test", {}, Resource::Optional };
+    const Resource missingResource { Resource::Unknown, "http://127.0.0.1:3000/missing", {}, Resource::Optional };
+
+    Response response;
+    response.data = std::make_shared<std::string>("Cached value");
+    fs.put(cachedResource, response);
+
+    std::unique_ptr<AsyncRequest> req1;
+    std::unique_ptr<AsyncRequest> req2;
+    int responses = 0;
+
+    req1 = fs.request(cachedResource, [&](Response res) {
+        req1.reset();
+        EXPECT_EQ(nullptr, res.error);
+        ASSERT_TRUE(res.data.get());
+        EXPECT_EQ("Cached value", *res.data);
+        if (++responses == 2) {
+            loop.stop();
+        }
+    });
+
+    req2 = fs.request(missingResource, [&](Response res) {
+        req2.reset();
+        ASSERT_TRUE(res.error.get());
+        EXPECT_EQ(Response::Error::Reason::NotFound, res.error->reason);
+        EXPECT_FALSE(res.data);
+        if (++responses == 2) {
+            loop.stop();
+        }
+    });
+
+    loop.run();
+}
+
+namespace {
+
+class CountingCodec : public OfflineCodec {
+public:
+    std::string compress(const std::string& data) override {
+        ++compressed;
+        return "prefix" + util::compress(data);
+    }
+
+    std::string decompress(const std::string& data) override {
+        ++decompressed;
+        EXPECT_EQ(0u, data.find("prefix"));
+        return util::decompress(data.substr(6));
+    }
+
+    std::atomic<int> compressed { 0 };
+    std::atomic<int> decompressed { 0 };
+};
+
+} // namespace
+
+// Codecs are registered with both connections, and are required to read what they stored.
+TEST(DefaultFileSource, TEST_REQUIRES_WRITE(OfflineCodec)) {
+    util::RunLoop loop;
+    try {
+        util::deleteFile("test/fixtures/storage/cache.db");
+    } catch (const util::IOException&) {
+    }
+
+    const Resource tile = Resource::tile("http://127.0.0.1:3000/{z}-{x}-{y}", 1, 0, 0, 0, Tileset::Scheme::XYZ);
+    Resource optionalTile = tile;
+    optionalTile.necessity = Resource::Optional;
+
+    Response response;
+    response.data = std::make_shared<std::string>(std::string(1024, 'a'));
+
+    auto codec = std::make_shared<CountingCodec>();
+
+    {
+        DefaultFileSource fs("test/fixtures/storage/cache.db", ".");
+        fs.addOfflineCodec(2, codec, { Resource::Tile });
+        fs.put(tile, response);
+        EXPECT_EQ(1, codec->compressed);
+
+        std::unique_ptr<AsyncRequest> req;
+        req = fs.request(optionalTile, [&](Response res) {
+            req.reset();
+            EXPECT_EQ(nullptr, res.error);
+            ASSERT_TRUE(res.data.get());
+            EXPECT_EQ(*response.data, *res.data);
+            loop.stop();
+        });
+
+        loop.run();
+        EXPECT_EQ(1, codec->decompressed);
+    }
+
+    DefaultFileSource fs("test/fixtures/storage/cache.db", ".");
+
+    std::unique_ptr<AsyncRequest> req;
+    req = fs.request(optionalTile, [&](Response res) {
+        req.reset();
+        ASSERT_TRUE(res.error.get());
+        EXPECT_EQ(Response::Error::Reason::NotFound, res.error->reason);
+        EXPECT_FALSE(res.data);
+        loop.stop();
+    });
+
+    loop.run();
+    EXPECT_EQ(1, codec->decompressed);
+}
+
 // Test that we can make a request with etag data that doesn't first try to load
 // from cache like a regular request
 TEST(DefaultFileSource, TEST_REQUIRES_SERVER(NoCacheRefreshEtagNotModified)) {
@@ -4,6 +4,7 @@
 #include <mbgl/storage/offline_database.hpp>
 #include <mbgl/storage/resource.hpp>
 #include <mbgl/storage/response.hpp>
+#include <mbgl/util/compression.hpp>
 #include <mbgl/util/io.hpp>
 #include <mbgl/util/string.hpp>
 
@@ -397,6 +398,113 @@ static std::shared_ptr<std::string> randomString(size_t size) {
     return result;
 }
 
+TEST(OfflineDatabase, TEST_REQUIRES_WRITE(ReadOnly)) {
+    using namespace mbgl;
+
+    createDir("test/fixtures/offline_database");
+    deleteFile("test/fixtures/offline_database/offline.db");
+    std::string path("test/fixtures/offline_database/offline.db");
+
+    OfflineDatabase db(path);
+    OfflineDatabase reader(path, OfflineDatabase::ReadOnly());
+
+    Resource resource { Resource::Style, "http://example.com/" };
+    Response response;
+    response.data = std::make_shared<std::string>("data");
+
+    EXPECT_FALSE(bool(reader.get(resource)));
+    db.put(resource, response);
+    auto result = reader.get(resource);
+    ASSERT_TRUE(bool(result));
+    EXPECT_EQ("data", *result->data);
+
+    // The reader doesn't wait for writes in progress, and doesn't see them.
+    Resource other { Resource::Style, "http://example.com/other" };
+    db.beginBatch();
+    db.put(other, response);
+    EXPECT_TRUE(bool(reader.get(resource)));
+    EXPECT_FALSE(bool(reader.get(other)));
+    db.endBatch();
+    EXPECT_TRUE(bool(reader.get(other)));
+
+    // Only the writer records access times.
+    auto accessed = [&] {
+        mapbox::sqlite::Database raw(path, mapbox::sqlite::ReadOnly);
+        auto stmt = raw.prepare("SELECT accessed FROM resources WHERE url = 'http://example.com/'");
+        stmt.run();
+        return stmt.get<int64_t>(0);
+    };
+
+    const int64_t written = accessed();
+    std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+    reader.get(resource);
+    EXPECT_EQ(written, accessed());
+    db.markAccessed(resource);
+    EXPECT_LT(written, accessed());
+}
+
+namespace {
+
+class PrefixCodec : public mbgl::OfflineCodec {
+public:
+    std::string compress(const std::string& data) override {
+        return "prefix" + mbgl::util::compress(data);
+    }
+
+    std::string decompress(const std::string& data) override {
+        EXPECT_EQ(0u, data.find("prefix"));
+        return mbgl::util::decompress(data.substr(6));
+    }
+};
+
+} // namespace
+
+TEST(OfflineDatabase, TEST_REQUIRES_WRITE(Codecs)) {
+    using namespace mbgl;
+
+    createDir("test/fixtures/offline_database");
+    deleteFile("test/fixtures/offline_database/offline.db");
+    std::string path("test/fixtures/offline_database/offline.db");
+
+    OfflineDatabase db(path);
+    db.addCodec(2, std::make_shared<PrefixCodec>());
+
+    Resource style { Resource::Style, "http://example.com/style" };
+    Resource tile = Resource::tile("http://example.com/{z}-{x}-{y}", 1, 0, 0, 0, Tileset::Scheme::XYZ);
+    Response response;
+    response.data = std::make_shared<std::string>(std::string(1024, 'a'));
+
+    db.put(tile, response);
+    db.useCodec(Resource::Kind::Tile, 2);
+    db.useCodec(Resource::Kind::Style, OfflineCodec::Uncompressed);
+    db.put(style, response);
+    EXPECT_EQ(*response.data, *db.get(style)->data);
+    EXPECT_EQ(*response.data, *db.get(tile)->data);
+
+    auto codec = [&](const char* sql) {
+        mapbox::sqlite::Database raw(path, mapbox::sqlite::ReadOnly);
+        auto stmt = raw.prepare(sql);
+        stmt.run();
+        return stmt.get<int>(0);
+    };
+
+    EXPECT_EQ(0, codec("SELECT compressed FROM resources"));
+    EXPECT_EQ(1, codec("SELECT compressed FROM tiles"));
+
+    db.put(tile, response);
+    EXPECT_EQ(2, codec("SELECT compressed FROM tiles"));
+    EXPECT_EQ(*response.data, *db.get(tile)->data);
+
+    // Without the codec, the tile can't be read.
+    OfflineDatabase reader(path, OfflineDatabase::ReadOnly());
+    EXPECT_TRUE(bool(reader.get(style)));
+    EXPECT_FALSE(bool(reader.get(tile)));
+    reader.addCodec(2, std::make_shared<PrefixCodec>());
+    EXPECT_EQ(*response.data, *reader.get(tile)->data);
+
+    EXPECT_THROW(db.useCodec(Resource::Kind::Tile, 3), std::runtime_error);
+}
+
 TEST(OfflineDatabase, PutReturnsSize) {
     using namespace mbgl;
 
@@ -549,6 +657,143 @@ TEST(OfflineDatabase, HasRegionResourceTile) {
 
 }
 
+static int64_t countRegionTiles(const std::string& path) {
+    mapbox::sqlite::Database db(path.c_str(), mapbox::sqlite::ReadOnly);
+    auto stmt = db.prepare("SELECT COUNT(*) FROM region_tiles");
+    stmt.run();
+    return stmt.get<int64_t>(0);
+}
+
+TEST(OfflineDatabase, TEST_REQUIRES_WRITE(BatchedWrites)) {
+    using namespace mbgl;
+
+    createDir("test/fixtures/offline_database");
+    deleteFile("test/fixtures/offline_database/offline.db");
+    std::string path("test/fixtures/offline_database/offline.db");
+
+    OfflineDatabase db(path);
+    OfflineRegionDefinition definition { "http://example.com/style", LatLngBounds::world(), 0, INFINITY, 1.0 };
+    OfflineRegion region = db.createRegion(definition, OfflineRegionMetadata());
+
+    Response response;
+    response.data = std::make_shared<std::string>("data");
+
+    auto tile = [] (int32_t x) {
+        return Resource::tile("http://example.com/{z}-{x}-{y}", 1.0, x, 0, 10, Tileset::Scheme::XYZ);
+    };
+
+    db.beginBatch(3, Seconds(60));
+
+    // Writes are visible to the writer before they are committed.
+    db.putRegionResource(region.getID(), tile(0), response);
+    db.putRegionResource(region.getID(), tile(1), response);
+    EXPECT_TRUE(bool(db.get(tile(1))));
+    EXPECT_EQ(2u, db.getRegionCompletedStatus(region.getID()).completedTileCount);
+    EXPECT_EQ(0, countRegionTiles(path));
+
+    // The batch is committed once it is full.
+    db.putRegionResource(region.getID(), tile(2), response);
+    EXPECT_EQ(3, countRegionTiles(path));
+
+    db.putRegionResource(region.getID(), tile(3), response);
+    EXPECT_EQ(3, countRegionTiles(path));
+    db.commitBatch();
+    EXPECT_EQ(4, countRegionTiles(path));
+
+    // Nested batches are committed when the outermost one ends.
+    db.beginBatch();
+    db.putRegionResource(region.getID(), tile(4), response);
+    db.endBatch();
+    EXPECT_EQ(4, countRegionTiles(path));
+    db.endBatch();
+    EXPECT_EQ(5, countRegionTiles(path));
+
+    // Outside of a batch, each write is committed on its own.
+    db.putRegionResource(region.getID(), tile(5), response);
+    EXPECT_EQ(6, countRegionTiles(path));
+}
+
+TEST(OfflineDatabase, TEST_REQUIRES_WRITE(BatchedWritesDuration)) {
+    using namespace mbgl;
+
+    createDir("test/fixtures/offline_database");
+    deleteFile("test/fixtures/offline_database/offline.db");
+    std::string path("test/fixtures/offline_database/offline.db");
+
+    OfflineDatabase db(path);
+    OfflineRegionDefinition definition { "http://example.com/style", LatLngBounds::world(), 0, INFINITY, 1.0 };
+    OfflineRegion region = db.createRegion(definition, OfflineRegionMetadata());
+
+    Response response;
+    response.data = std::make_shared<std::string>("data");
+
+    // A batch without time to spare commits every write.
+    db.beginBatch(100, Duration::zero());
+    db.putRegionResource(region.getID(), Resource::tile("http://example.com/{z}-{x}-{y}", 1.0, 0, 0, 0, Tileset::Scheme::XYZ), response);
+    EXPECT_EQ(1, countRegionTiles(path));
+    db.endBatch();
+}
+
+TEST(OfflineDatabase, TEST_REQUIRES_WRITE(BatchedWriteFailure)) {
+    using namespace mbgl;
+
+    createDir("test/fixtures/offline_database");
+    deleteFile("test/fixtures/offline_database/offline.db");
+    std::string path("test/fixtures/offline_database/offline.db");
+
+    OfflineDatabase db(path);
+
+    // Like SQLite does after some errors, such as a full disk, these triggers roll back the
+    // whole transaction.
+    {
+        mapbox::sqlite::Database raw(path, mapbox::sqlite::ReadWrite);
+        raw.exec("CREATE TRIGGER failWrite BEFORE INSERT ON resources "
+                 "WHEN NEW.url = 'http://example.com/failWrite' "
+                 "BEGIN SELECT RAISE(ROLLBACK, 'forced failure'); END");
+        raw.exec("CREATE TRIGGER failRead BEFORE UPDATE ON resources "
+                 "WHEN OLD.url = 'http://example.com/failRead' "
+                 "BEGIN SELECT RAISE(ROLLBACK, 'forced failure'); END");
+    }
+
+    Response response;
+    response.data = std::make_shared<std::string>("data");
+    Resource first { Resource::Style, "http://example.com/first" };
+    Resource second { Resource::Style, "http://example.com/second" };
+    Resource failWrite { Resource::Style, "http://example.com/failWrite" };
+    Resource failRead { Resource::Style, "http://example.com/failRead" };
+
+    db.put(failRead, response);
+
+    // A failed write rolls back the writes batched with it, and the next write starts over.
+    db.beginBatch();
+    db.put(first, response);
+    EXPECT_THROW(db.put(failWrite, response), mapbox::sqlite::Exception);
+    EXPECT_NO_THROW(db.commitBatch());
+    EXPECT_FALSE(bool(db.get(first)));
+    db.put(second, response);
+    db.commitBatch();
+    EXPECT_TRUE(bool(db.get(second)));
+
+    // A transaction that SQLite rolled back outside of a write is not committed.
+    db.put(first, response);
+    EXPECT_THROW(db.get(failRead), mapbox::sqlite::Exception);
+    EXPECT_THROW(db.endBatch(), mapbox::sqlite::Exception);
+    EXPECT_FALSE(bool(db.get(first)));
+
+    // The tiles counted by a batch that is rolled back are no longer counted.
+    OfflineRegionDefinition definition { "http://example.com/style", LatLngBounds::hull({1, 2}, {3, 4}), 5, 6, 2.0 };
+    OfflineRegion region = db.createRegion(definition, OfflineRegionMetadata());
+    Resource mapboxTile = Resource::tile("mapbox://tiles/1", 1.0, 0, 0, 0, Tileset::Scheme::XYZ);
+
+    EXPECT_EQ(0u, db.getOfflineMapboxTileCount());
+    db.beginBatch();
+    db.putRegionResource(region.getID(), mapboxTile, response);
+    EXPECT_EQ(1u, db.getOfflineMapboxTileCount());
+    EXPECT_THROW(db.putRegionResource(region.getID(), failWrite, response), mapbox::sqlite::Exception);
+    EXPECT_EQ(0u, db.getOfflineMapboxTileCount());
+    db.endBatch();
+}
+
 TEST(OfflineDatabase, OfflineMapboxTileCount) {
     using namespace mbgl;
 
@@ -627,31 +872,24 @@ static std::string databaseJournalMode(const std::string& path) {
     return stmt.get<std::string>(0);
 }
 
-static int databaseSyncMode(const std::string& path) {
-    mapbox::sqlite::Database db(path, mapbox::sqlite::ReadOnly);
-    mapbox::sqlite::Statement stmt = db.prepare("pragma synchronous");
-    stmt.run();
-    return stmt.get<int>(0);
-}
-
 TEST(OfflineDatabase, MigrateFromV2Schema) {
     using namespace mbgl;
 
     // v2.db is a v2 database containing a single offline region with a small number of resources.
 
-    deleteFile("test/fixtures/offline_database/v5.db");
-    writeFile("test/fixtures/offline_database/v5.db", util::read_file("test/fixtures/offline_database/v2.db"));
+    deleteFile("test/fixtures/offline_database/v6.db");
+    writeFile("test/fixtures/offline_database/v6.db", util::read_file("test/fixtures/offline_database/v2.db"));
 
     {
-        OfflineDatabase db("test/fixtures/offline_database/v5.db", 0);
+        OfflineDatabase db("test/fixtures/offline_database/v6.db", 0);
         auto regions = db.listRegions();
         for (auto& region : regions) {
             db.deleteRegion(std::move(region));
         }
     }
 
-    EXPECT_EQ(5, databaseUserVersion("test/fixtures/offline_database/v5.db"));
-    EXPECT_LT(databasePageCount("test/fixtures/offline_database/v5.db"),
+    EXPECT_EQ(6, databaseUserVersion("test/fixtures/offline_database/v6.db"));
+    EXPECT_LT(databasePageCount("test/fixtures/offline_database/v6.db"),
               databasePageCount("test/fixtures/offline_database/v2.db"));
 }
 
@@ -660,18 +898,18 @@ TEST(OfflineDatabase, MigrateFromV3Schema) {
 
     // v3.db is a v3 database, migrated from v2.
 
-    deleteFile("test/fixtures/offline_database/v5.db");
-    writeFile("test/fixtures/offline_database/v5.db", util::read_file("test/fixtures/offline_database/v3.db"));
+    deleteFile("test/fixtures/offline_database/v6.db");
+    writeFile("test/fixtures/offline_database/v6.db", util::read_file("test/fixtures/offline_database/v3.db"));
 
     {
-        OfflineDatabase db("test/fixtures/offline_database/v5.db", 0);
+        OfflineDatabase db("test/fixtures/offline_database/v6.db", 0);
         auto regions = db.listRegions();
         for (auto& region : regions) {
             db.deleteRegion(std::move(region));
         }
     }
 
-    EXPECT_EQ(5, databaseUserVersion("test/fixtures/offline_database/v5.db"));
+    EXPECT_EQ(6, databaseUserVersion("test/fixtures/offline_database/v6.db"));
 }
 
 TEST(OfflineDatabase, MigrateFromV4Schema) {
@@ -679,22 +917,20 @@ TEST(OfflineDatabase, MigrateFromV4Schema) {
 
     // v4.db is a v4 database, migrated from v2 & v3. This database used `journal_mode = WAL` and `synchronous = NORMAL`.
 
-    deleteFile("test/fixtures/offline_database/v5.db");
-    writeFile("test/fixtures/offline_database/v5.db", util::read_file("test/fixtures/offline_database/v4.db"));
+    deleteFile("test/fixtures/offline_database/v6.db");
+    writeFile("test/fixtures/offline_database/v6.db", util::read_file("test/fixtures/offline_database/v4.db"));
 
     {
-        OfflineDatabase db("test/fixtures/offline_database/v5.db", 0);
+        OfflineDatabase db("test/fixtures/offline_database/v6.db", 0);
         auto regions = db.listRegions();
         for (auto& region : regions) {
             db.deleteRegion(std::move(region));
         }
     }
 
-    EXPECT_EQ(5, databaseUserVersion("test/fixtures/offline_database/v5.db"));
-
-    // Journal mode should be DELETE after migration to v5.
-    EXPECT_EQ("delete", databaseJournalMode("test/fixtures/offline_database/v5.db"));
+    EXPECT_EQ(6, databaseUserVersion("test/fixtures/offline_database/v6.db"));
 
-    // Synchronous setting should be FULL (2) after migration to v5.
-    EXPECT_EQ(2, databaseSyncMode("test/fixtures/offline_database/v5.db"));
+    // Journal mode should be WAL after migration to v6. Unlike the journal mode, the
+    // synchronous setting is not stored in the database.
+    EXPECT_EQ("wal", databaseJournalMode("test/fixtures/offline_database/v6.db"));
 }
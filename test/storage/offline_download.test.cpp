@@ -1,3 +1,4 @@
+#include <mbgl/test/util.hpp>
 #include <mbgl/test/stub_file_source.hpp>
 #include <mbgl/test/fake_file_source.hpp>
 
@@ -11,6 +12,7 @@
 #include <mbgl/util/string.hpp>
 
 #include <gtest/gtest.h>
+#include <sqlite3.hpp>
 #include <iostream>
 
 using namespace mbgl;
@@ -358,6 +360,63 @@ TEST(OfflineDownload, RequestError) {
     test.loop.run();
 }
 
+TEST(OfflineDownload, TEST_REQUIRES_WRITE(StorageError)) {
+    OfflineTest test;
+    const std::string path = "test/fixtures/offline_download/offline.db";
+    try {
+        util::deleteFile(path);
+    } catch (const util::IOException&) {
+    }
+
+    OfflineDatabase db(path);
+    OfflineRegionDefinition definition { "", LatLngBounds::hull({1, 2}, {3, 4}), 5, 6, 1.0 };
+    OfflineRegion region = db.createRegion(definition, OfflineRegionMetadata());
+    OfflineDownload download(
+        region.getID(),
+        OfflineTilePyramidRegionDefinition("http://127.0.0.1:3000/style.json", LatLngBounds::world(), 0.0, 0.0, 1.0),
+        db, test.fileSource);
+
+    // Storing the tile fails, which rolls back the style batched with it.
+    {
+        mapbox::sqlite::Database raw(path, mapbox::sqlite::ReadWrite);
+        raw.exec("CREATE TRIGGER failWrite BEFORE INSERT ON tiles "
+                 "BEGIN SELECT RAISE(ROLLBACK, 'forced failure'); END");
+    }
+
+    test.fileSource.styleResponse = [&] (const Resource&) {
+        return test.response("inline_source.style.json");
+    };
+
+    test.fileSource.tileResponse = [&] (const Resource&) {
+        return test.response("0-0-0.vector.pbf");
+    };
+
+    auto observer = std::make_unique<MockObserver>();
+
+    bool storageError = false;
+    observer->responseErrorFn = [&] (Response::Error error) {
+        EXPECT_EQ(Response::Error::Reason::Other, error.reason);
+        storageError = true;
+    };
+
+    observer->statusChangedFn = [&] (OfflineRegionStatus status) {
+        if (status.downloadState == OfflineRegionDownloadState::Inactive) {
+            // The status only counts what has been stored.
+            const OfflineRegionStatus stored = db.getRegionCompletedStatus(region.getID());
+            EXPECT_TRUE(storageError);
+            EXPECT_EQ(0u, status.completedTileCount);
+            EXPECT_EQ(stored.completedResourceCount, status.completedResourceCount);
+            EXPECT_EQ(stored.completedResourceSize, status.completedResourceSize);
+            test.loop.stop();
+        }
+    };
+
+    download.setObserver(std::move(observer));
+    download.setState(OfflineRegionDownloadState::Active);
+
+    test.loop.run();
+}
+
 TEST(OfflineDownload, RequestErrorsAreRetried) {
     OfflineTest test;
     OfflineRegion region = test.createRegion();
@@ -4,9 +4,12 @@
 
 #include <mbgl/style/filter.hpp>
 #include <mbgl/style/filter_evaluator.hpp>
+#include <mbgl/style/compiled_filter.hpp>
 #include <mbgl/style/rapidjson_conversion.hpp>
 #include <mbgl/style/conversion.hpp>
 #include <mbgl/style/conversion/filter.hpp>
+#include <mbgl/tile/vector_tile_data.hpp>
+#include <mbgl/util/io.hpp>
 
 #include <rapidjson/document.h>
 
@@ -126,3 +129,39 @@ TEST(Filter, ID) {
 
     ASSERT_FALSE(parse("[\"==\", \"$id\", 1234]")(feature2));
 }
+
+TEST(Filter, Compiled) {
+    VectorTileData data(std::make_shared<std::string>(
+        util::read_file("test/fixtures/api/assets/streets/10-163-395.vector.pbf")));
+
+    const GeometryTileLayer* layer = data.getLayer("road");
+    ASSERT_TRUE(layer);
+
+    for (const char* expression : {
+        R"(["==", "class", "primary"])",
+        R"(["!=", "class", "primary"])",
+        R"(["in", "class", "primary", "motorway", "motorway_link"])",
+        R"(["!in", "class", "primary", "motorway"])",
+        R"([">", "class", "motorway"])",
+        R"(["<", "class", 3])",
+        R"(["has", "oneway"])",
+        R"(["!has", "oneway"])",
+        R"(["==", "missing", "primary"])",
+        R"(["!in", "missing", "primary"])",
+        R"(["==", "$type", "LineString"])",
+        R"(["!in", "$type", "Point", "Polygon"])",
+        R"(["has", "$id"])",
+        R"(["all", ["==", "$type", "LineString"], ["in", "class", "primary", "motorway"]])",
+        R"(["any", ["==", "structure", "bridge"], ["!=", "oneway", "false"]])",
+        R"(["none", ["==", "class", "primary"], ["has", "missing"]])",
+        R"(["all"])",
+    }) {
+        const Filter filter = parse(expression);
+        const CompiledFilter compiled(filter, *layer);
+
+        layer->eachFeature([&] (std::size_t, const GeometryTileFeature& tileFeature) {
+            EXPECT_EQ(filter(tileFeature), compiled(tileFeature)) << expression;
+            return true;
+        });
+    }
+}
@@ -15,6 +15,7 @@
 #include <mbgl/util/logging.hpp>
 #include <mbgl/util/optional.hpp>
 #include <mbgl/util/range.hpp>
+#include <mbgl/util/tile_cover.hpp>
 
 #include <mbgl/map/transform.hpp>
 #include <mbgl/style/style.hpp>
@@ -25,7 +26,10 @@
 
 #include <mapbox/geojsonvt.hpp>
 
+#include <algorithm>
 #include <cstdint>
+#include <map>
+#include <set>
 
 using namespace mbgl;
 
@@ -374,6 +378,171 @@ TEST(Source, VectorTileCancel) {
     test.run();
 }
 
+TEST(Source, RasterTilePrefetch) {
+    SourceTest test;
+
+    bool prefetched = false;
+    test.fileSource.tileResponse = [&] (const Resource& resource) {
+        if (resource.url.compare(0, 2, "2/") == 0) {
+            prefetched = true;
+            test.end();
+        }
+        return optional<Response>();
+    };
+
+    Tileset tileset;
+    tileset.tiles = { "{z}/{x}/{y}" };
+
+    RasterSource source("source", tileset, 512);
+    source.baseImpl->setObserver(&test.observer);
+    source.baseImpl->loadDescription(test.fileSource);
+
+    // The camera is at zoom 0 and about to arrive at zoom 2.
+    Transform destination;
+    destination.resize({ 512, 512 });
+    destination.setLatLngZoom({ 0, 0 }, 2);
+
+    style::UpdateParameters prefetchParameters {
+        1.0,
+        MapDebugOptions(),
+        test.transformState,
+        test.threadPool,
+        test.fileSource,
+        MapMode::Continuous,
+        test.annotationManager,
+        test.style,
+        { destination.getState() }
+    };
+
+    source.baseImpl->updateTiles(prefetchParameters);
+    test.run();
+    EXPECT_TRUE(prefetched);
+
+    auto pendingZoom = [&] (char z) {
+        const auto pending = test.fileSource.pendingResources();
+        return std::count_if(pending.begin(), pending.end(), [&] (const Resource& resource) {
+            return resource.url[0] == z;
+        });
+    };
+    EXPECT_LT(0, pendingZoom('2'));
+
+    // Once the animation is over, the prefetched tiles are dropped and their requests cancelled.
+    source.baseImpl->updateTiles(test.updateParameters);
+    EXPECT_EQ(0, pendingZoom('2'));
+    EXPECT_EQ(1, pendingZoom('0'));
+}
+
+TEST(Source, RasterTilePrefetchParent) {
+    SourceTest test;
+
+    // No tile ever finishes loading.
+    test.fileSource.tileResponse = [&] (const Resource&) {
+        return optional<Response>();
+    };
+
+    Tileset tileset;
+    tileset.tiles = { "{z}/{x}/{y}" };
+
+    RasterSource source("source", tileset, 512);
+    source.baseImpl->setObserver(&test.observer);
+    source.baseImpl->loadDescription(test.fileSource);
+
+    // The camera is at zoom 2 and about to arrive at zoom 0, whose tile is also the parent
+    // that stands in for the zoom 2 tiles while they load.
+    test.transform.setLatLngZoom({ 0, 0 }, 2);
+    test.transformState = test.transform.getState();
+
+    Transform destination;
+    destination.resize({ 512, 512 });
+    destination.setLatLngZoom({ 0, 0 }, 0);
+
+    style::UpdateParameters prefetchParameters {
+        1.0,
+        MapDebugOptions(),
+        test.transformState,
+        test.threadPool,
+        test.fileSource,
+        MapMode::Continuous,
+        test.annotationManager,
+        test.style,
+        { destination.getState() }
+    };
+
+    for (int frame = 0; frame < 3; ++frame) {
+        source.baseImpl->updateTiles(prefetchParameters);
+    }
+
+    // Each tile has been requested once, and its request is still pending.
+    auto countZoom = [] (const std::vector<Resource>& resources, char z) {
+        return std::count_if(resources.begin(), resources.end(), [&] (const Resource& resource) {
+            return resource.url[0] == z;
+        });
+    };
+    EXPECT_EQ(1, countZoom(test.fileSource.requestedResources, '0'));
+    EXPECT_EQ(1, countZoom(test.fileSource.pendingResources(), '0'));
+    EXPECT_EQ(countZoom(test.fileSource.pendingResources(), '2'),
+              countZoom(test.fileSource.requestedResources, '2'));
+}
+
+#if !defined(__ANDROID__) && !defined(__APPLE__) && !defined(QT_IMAGE_DECODERS)
+TEST(Source, RasterTileFractionalZoom) {
+    SourceTest test;
+
+    test.fileSource.tileResponse = [&] (const Resource&) {
+        Response response;
+        response.data = std::make_shared<std::string>(util::read_file("test/fixtures/image/tile.jpeg"));
+        return response;
+    };
+
+    // At zoom 1.3, tiles of size 128 and 64 are drawn at zoom level 3 and 4 respectively,
+    // at up to 157 and 79 pixels.
+    test.transform.setZoom(1.3);
+    test.transformState = test.transform.getState();
+
+    // Decodes the 256 pixel tiles of a source, and returns the sizes they are decoded at.
+    auto decodedSizes = [&] (uint16_t tileSize, const Tileset& tileset, int32_t z) {
+        RasterSource source("source", tileset, tileSize);
+        source.baseImpl->setObserver(&test.observer);
+        source.baseImpl->loadDescription(test.fileSource);
+
+        const size_t expected = util::tileCover(test.transformState, z).size();
+        size_t parsed = 0;
+        test.observer.tileChanged = [&] (Source&, const OverscaledTileID& tileID) {
+            EXPECT_EQ(z, tileID.canonical.z);
+            if (++parsed == expected) {
+                test.end();
+            }
+        };
+
+        source.baseImpl->updateTiles(test.updateParameters);
+        test.run();
+
+        source.baseImpl->updateTiles(test.updateParameters);
+        std::set<size_t> result;
+        for (auto& pair : source.baseImpl->getRenderTiles()) {
+            result.insert(pair.second.tile.memoryUsage().cpu);
+        }
+        EXPECT_EQ(expected, source.baseImpl->getRenderTiles().size());
+        test.observer.tileChanged = nullptr;
+        return result;
+    };
+
+    const size_t full = 256 * 256 * 4;
+    const size_t half = 128 * 128 * 4;
+
+    Tileset tileset;
+    tileset.tiles = { "{z}/{x}/{y}" };
+
+    // Halving would show fewer pixels than the tiles cover.
+    EXPECT_EQ(std::set<size_t>({ full }), decodedSizes(128, tileset, 3));
+    EXPECT_EQ(std::set<size_t>({ half }), decodedSizes(64, tileset, 4));
+
+    // Tiles at the maximum zoom level may be overzoomed.
+    tileset.zoomRange.max = 3;
+    EXPECT_EQ(std::set<size_t>({ full }), decodedSizes(64, tileset, 3));
+}
+#endif // !defined(__ANDROID__) && !defined(__APPLE__) && !defined(QT_IMAGE_DECODERS)
+
 TEST(Source, RasterTileAttribution) {
     SourceTest test;
 
@@ -446,3 +615,78 @@ TEST(Source, GeoJSonSourceUrlUpdate) {
 
     test.run();
 }
+
+TEST(Source, GeoJSONSourceIndexedAsynchronously) {
+    SourceTest test;
+
+    test.observer.tileChanged = [&] (Source& source, const OverscaledTileID&) {
+        // Only the data of the latest setGeoJSON call is used.
+        EXPECT_EQ(2u, source.querySourceFeatures().size());
+        test.end();
+    };
+
+    mapbox::geometry::feature_collection<double> first;
+    first.push_back(mapbox::geometry::feature<double> { mapbox::geometry::point<double>(0, 0) });
+
+    mapbox::geometry::feature_collection<double> second = first;
+    second.push_back(mapbox::geometry::feature<double> { mapbox::geometry::point<double>(1, 1) });
+
+    GeoJSONSource source("source");
+    source.baseImpl->setObserver(&test.observer);
+    source.setGeoJSON(GeoJSON{ first });
+    source.baseImpl->loadDescription(test.fileSource);
+    source.baseImpl->updateTiles(test.updateParameters);
+
+    // Supersedes the build that has just been started.
+    source.setGeoJSON(GeoJSON{ second });
+
+    test.run();
+}
+
+TEST(Source, GeoJSONSourceUpdateReloadsChangedTiles) {
+    SourceTest test;
+    test.transform.setLatLngZoom({ 0, 0 }, 2);
+    test.transformState = test.transform.getState();
+
+    auto makeFeature = [] (uint64_t id, double lon, double lat) {
+        mapbox::geometry::feature<double> feature { mapbox::geometry::point<double>(lon, lat) };
+        feature.id = FeatureIdentifier(id);
+        return feature;
+    };
+
+    // One feature in tile 2/1/1, the other in 2/2/2.
+    mapbox::geometry::feature_collection<double> features;
+    features.push_back(makeFeature(1, -45, 30));
+    features.push_back(makeFeature(2, 45, -30));
+
+    GeoJSONSource source("source");
+    const std::size_t tileCount = util::tileCover(test.transformState, 2).size();
+    std::map<OverscaledTileID, int> changes;
+    bool updated = false;
+
+    test.observer.tileChanged = [&] (Source&, const OverscaledTileID& tileID) {
+        if (updated) {
+            EXPECT_EQ(OverscaledTileID(2, 2, 2), tileID);
+            test.end();
+            return;
+        }
+
+        // Once every tile has been laid out and placed, move the feature in 2/2/2.
+        changes[tileID]++;
+        if (changes.size() == tileCount &&
+            std::all_of(changes.begin(), changes.end(), [] (const auto& pair) { return pair.second == 2; })) {
+            updated = true;
+
+            GeoJSONSourceDiff diff;
+            diff.update.push_back(makeFeature(2, 46, -31));
+            source.updateGeoJSON(diff);
+        }
+    };
+
+    source.baseImpl->setObserver(&test.observer);
+    source.setGeoJSON(GeoJSON{ features });
+    source.baseImpl->loadDescription(test.fileSource);
+    source.baseImpl->updateTiles(test.updateParameters);
+
+    test.run();
+}
@@ -70,3 +70,77 @@ TEST(GeoJSONTile, Issue7648) {
         test.loop.runOnce();
     }
 }
+
+TEST(GeoJSONTile, IncrementalLayout) {
+    GeoJSONTileTest test;
+    GeoJSONTile tile(OverscaledTileID(0, 0, 0), "source", test.updateParameters);
+
+    // Different filters put the layers in separate layer groups.
+    test.style.addLayer(std::make_unique<CircleLayer>("a", "source"));
+    test.style.addLayer(std::make_unique<CircleLayer>("b", "source"));
+    test.style.getLayer("b")->as<CircleLayer>()->setFilter(NotHasFilter { "missing" });
+
+    StubTileObserver observer;
+    tile.setObserver(&observer);
+    tile.setPlacementConfig({});
+
+    mapbox::geometry::feature_collection<int16_t> features;
+    features.push_back(mapbox::geometry::feature<int16_t> {
+        mapbox::geometry::point<int16_t>(0, 0)
+    });
+
+    tile.updateData(features);
+    while (!tile.isComplete()) {
+        test.loop.runOnce();
+    }
+
+    Bucket* a = tile.getBucket(*test.style.getLayer("a"));
+    Bucket* b = tile.getBucket(*test.style.getLayer("b"));
+    ASSERT_NE(nullptr, a);
+    ASSERT_NE(nullptr, b);
+    ASSERT_NE(a, b);
+
+    // Only the bucket of the changed layer is rebuilt.
+    test.style.getLayer("a")->as<CircleLayer>()->setFilter(NotHasFilter { "other" });
+    tile.redoLayout({ "a" });
+    while (!tile.isComplete()) {
+        test.loop.runOnce();
+    }
+
+    ASSERT_NE(nullptr, tile.getBucket(*test.style.getLayer("a")));
+    EXPECT_NE(a, tile.getBucket(*test.style.getLayer("a")));
+    EXPECT_EQ(b, tile.getBucket(*test.style.getLayer("b")));
+    a = tile.getBucket(*test.style.getLayer("a"));
+
+    // A data-driven paint property leaves the layout key as it is, so the group is rebuilt
+    // only because its layer is listed as changed.
+    test.style.getLayer("a")->as<CircleLayer>()->setCircleRadius(
+        SourceFunction<float>("radius", IdentityStops<float>()));
+    tile.redoLayout({ "a" });
+    while (!tile.isComplete()) {
+        test.loop.runOnce();
+    }
+
+    ASSERT_NE(nullptr, tile.getBucket(*test.style.getLayer("a")));
+    EXPECT_NE(a, tile.getBucket(*test.style.getLayer("a")));
+    EXPECT_EQ(b, tile.getBucket(*test.style.getLayer("b")));
+    a = tile.getBucket(*test.style.getLayer("a"));
+
+    // Without changed layers, all buckets are reused.
+    tile.redoLayout({});
+    while (!tile.isComplete()) {
+        test.loop.runOnce();
+    }
+
+    EXPECT_EQ(a, tile.getBucket(*test.style.getLayer("a")));
+    EXPECT_EQ(b, tile.getBucket(*test.style.getLayer("b")));
+
+    // New data rebuilds all buckets.
+    tile.updateData(features);
+    while (!tile.isComplete()) {
+        test.loop.runOnce();
+    }
+
+    ASSERT_NE(nullptr, tile.getBucket(*test.style.getLayer("b")));
+    EXPECT_NE(b, tile.getBucket(*test.style.getLayer("b")));
+}
@@ -0,0 +1,59 @@
+#include <mbgl/test/util.hpp>
+#include <mbgl/test/stub_geometry_tile_feature.hpp>
+
+#include <mbgl/tile/geometry_cache.hpp>
+
+using namespace mbgl;
+
+namespace {
+
+class CountingFeature : public StubGeometryTileFeature {
+public:
+    CountingFeature() : StubGeometryTileFeature({}) {
+        geometry = { { { 0, 0 }, { 10, 10 }, { 20, 0 } } };
+    }
+
+    GeometryCollection getGeometries() const override {
+        decodes++;
+        return geometry;
+    }
+
+    mutable std::size_t decodes = 0;
+};
+
+class StubLayer : public GeometryTileLayer {
+public:
+    std::size_t featureCount() const override { return 2; }
+    std::unique_ptr<GeometryTileFeature> getFeature(std::size_t) const override { return nullptr; }
+    std::string getName() const override { return ""; }
+};
+
+} // namespace
+
+TEST(GeometryCache, DecodesOnce) {
+    GeometryCache cache;
+    StubLayer layer;
+    CountingFeature feature;
+
+    EXPECT_EQ(feature.geometry, cache.getGeometries(layer, 0, feature));
+    EXPECT_EQ(feature.geometry, cache.getGeometries(layer, 0, feature));
+    EXPECT_EQ(1u, feature.decodes);
+    EXPECT_LT(0u, cache.bytes());
+
+    // Other indices and layers are cached separately.
+    cache.getGeometries(layer, 1, feature);
+    StubLayer otherLayer;
+    cache.getGeometries(otherLayer, 0, feature);
+    EXPECT_EQ(3u, feature.decodes);
+}
+
+TEST(GeometryCache, MemoryCap) {
+    GeometryCache cache(0);
+    StubLayer layer;
+    CountingFeature feature;
+
+    EXPECT_EQ(feature.geometry, cache.getGeometries(layer, 0, feature));
+    EXPECT_EQ(feature.geometry, cache.getGeometries(layer, 0, feature));
+    EXPECT_EQ(2u, feature.decodes);
+    EXPECT_EQ(0u, cache.bytes());
+}
@@ -0,0 +1,160 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/tile/geometry_decoder.hpp>
+#include <mbgl/util/constants.hpp>
+
+#include <cmath>
+#include <random>
+
+using namespace mbgl;
+
+namespace {
+
+std::string encode(const std::vector<uint32_t>& values) {
+    std::string result;
+    for (uint32_t value : values) {
+        while (value >= 0x80) {
+            result.push_back(char((value & 0x7F) | 0x80));
+            value >>= 7;
+        }
+        result.push_back(char(value));
+    }
+    return result;
+}
+
+uint32_t zigzag(int32_t value) {
+    return (uint32_t(value) << 1) ^ uint32_t(value >> 31);
+}
+
+// The one-value-at-a-time decoder that decodeGeometry() replaces.
+GeometryCollection referenceDecode(const std::vector<uint32_t>& values, uint32_t extent) {
+    uint8_t cmd = 1;
+    uint32_t length = 0;
+    int32_t x = 0;
+    int32_t y = 0;
+    const float scale = float(util::EXTENT) / extent;
+
+    GeometryCollection lines;
+    lines.emplace_back();
+    GeometryCoordinates* line = &lines.back();
+
+    auto it = values.begin();
+    while (it != values.end()) {
+        if (length == 0) {
+            uint32_t cmdLength = *it++;
+            cmd = cmdLength & 0x7;
+            length = cmdLength >> 3;
+        }
+
+        --length;
+
+        if (cmd == 1 || cmd == 2) {
+            x += int32_t(*it >> 1) ^ -int32_t(*it & 1); it++;
+            y += int32_t(*it >> 1) ^ -int32_t(*it & 1); it++;
+
+            if (cmd == 1 && !line->empty()) {
+                lines.emplace_back();
+                line = &lines.back();
+            }
+
+            line->emplace_back(::round(x * scale), ::round(y * scale));
+        } else if (cmd == 7) {
+            if (!line->empty()) {
+                line->push_back((*line)[0]);
+            }
+        }
+    }
+
+    return lines;
+}
+
+} // namespace
+
+TEST(GeometryDecoder, Varints) {
+    std::mt19937 random(42);
+    for (std::size_t size = 0; size < 200; size++) {
+        std::vector<uint32_t> values;
+        for (std::size_t i = 0; i < size; i++) {
+            // Mostly single-byte values, with occasional wider ones.
+            const unsigned bits = random() % 8 ? 7 : 1 + random() % 32;
+            values.push_back(bits == 32 ? uint32_t(random()) : uint32_t(random() & ((1u << bits) - 1)));
+        }
+
+        const std::string bytes = encode(values);
+        std::vector<uint32_t> simd(bytes.size());
+        std::vector<uint32_t> scalar(bytes.size());
+        simd.resize(decodeVarints(bytes.data(), bytes.size(), simd.data()));
+        scalar.resize(decodeVarintsScalar(bytes.data(), bytes.size(), scalar.data()));
+
+        EXPECT_EQ(values, simd);
+        EXPECT_EQ(values, scalar);
+    }
+}
+
+TEST(GeometryDecoder, TruncatedVarint) {
+    const std::string bytes = encode({ 1, 2, 3, 300 }).substr(0, 4);
+    std::vector<uint32_t> out(bytes.size());
+    EXPECT_THROW(decodeVarints(bytes.data(), bytes.size(), out.data()), std::runtime_error);
+}
+
+TEST(GeometryDecoder, SpecificationExamples) {
+    // Examples from the Mapbox Vector Tile specification, section 4.3.5.
+    const std::string point = encode({ 9, 50, 34 });
+    EXPECT_EQ((GeometryCollection { { { 25, 17 } } }),
+              decodeGeometry(point.data(), point.size(), util::EXTENT));
+
+    const std::string multiPoint = encode({ 17, 10, 14, 3, 9 });
+    EXPECT_EQ((GeometryCollection { { { 5, 7 } }, { { 3, 2 } } }),
+              decodeGeometry(multiPoint.data(), multiPoint.size(), util::EXTENT));
+
+    const std::string lineString = encode({ 9, 4, 4, 18, 0, 16, 16, 0 });
+    EXPECT_EQ((GeometryCollection { { { 2, 2 }, { 2, 10 }, { 10, 10 } } }),
+              decodeGeometry(lineString.data(), lineString.size(), util::EXTENT));
+
+    const std::string polygon = encode({ 9, 6, 12, 18, 10, 12, 24, 44, 15 });
+    EXPECT_EQ((GeometryCollection { { { 3, 6 }, { 8, 12 }, { 20, 34 }, { 3, 6 } } }),
+              decodeGeometry(polygon.data(), polygon.size(), util::EXTENT));
+
+    const std::string empty;
+    EXPECT_EQ((GeometryCollection { {} }), decodeGeometry(empty.data(), empty.size(), util::EXTENT));
+}
+
+TEST(GeometryDecoder, MatchesReference) {
+    std::mt19937 random(7);
+    for (std::size_t iteration = 0; iteration < 500; iteration++) {
+        std::vector<uint32_t> values;
+        const std::size_t commands = random() % 8;
+        for (std::size_t c = 0; c < commands; c++) {
+            const uint32_t points = 1 + random() % 40;
+            switch (random() % 3) {
+            case 0: // moveTo
+                values.push_back((points << 3) | 1);
+                break;
+            case 1: // lineTo
+                values.push_back((points << 3) | 2);
+                break;
+            case 2: // closePath
+                values.push_back((1 << 3) | 7);
+                continue;
+            }
+            for (uint32_t p = 0; p < points; p++) {
+                const int32_t range = random() % 4 ? 64 : 4096;
+                values.push_back(zigzag(int32_t(random() % (2 * range)) - range));
+                values.push_back(zigzag(int32_t(random() % (2 * range)) - range));
+            }
+        }
+
+        const std::string bytes = encode(values);
+        for (uint32_t extent : { 4096u, 8192u, 512u, 16384u, 3000u }) {
+            EXPECT_EQ(referenceDecode(values, extent), decodeGeometry(bytes.data(), bytes.size(), extent));
+        }
+    }
+}
+
+TEST(GeometryDecoder, Errors) {
+    const std::string unknown = encode({ 9, 50, 34, 8 | 3 });
+    EXPECT_THROW(decodeGeometry(unknown.data(), unknown.size(), util::EXTENT), std::runtime_error);
+
+    const std::string truncated = encode({ 9, 50 });
+    EXPECT_THROW(decodeGeometry(truncated.data(), truncated.size(), util::EXTENT), std::runtime_error);
+}
@@ -37,28 +37,28 @@ public:
 
 TEST(RasterTile, setError) {
     RasterTileTest test;
-    RasterTile tile(OverscaledTileID(0, 0, 0), test.updateParameters, test.tileset);
+    RasterTile tile(OverscaledTileID(0, 0, 0), test.updateParameters, test.tileset, 512);
     tile.setError(std::make_exception_ptr(std::runtime_error("test")));
     EXPECT_FALSE(tile.isRenderable());
 }
 
 TEST(RasterTile, onError) {
     RasterTileTest test;
-    RasterTile tile(OverscaledTileID(0, 0, 0), test.updateParameters, test.tileset);
+    RasterTile tile(OverscaledTileID(0, 0, 0), test.updateParameters, test.tileset, 512);
     tile.onError(std::make_exception_ptr(std::runtime_error("test")));
     EXPECT_FALSE(tile.isRenderable());
 }
 
 TEST(RasterTile, onParsed) {
     RasterTileTest test;
-    RasterTile tile(OverscaledTileID(0, 0, 0), test.updateParameters, test.tileset);
+    RasterTile tile(OverscaledTileID(0, 0, 0), test.updateParameters, test.tileset, 512);
     tile.onParsed(std::make_unique<RasterBucket>(UnassociatedImage{}));
     EXPECT_TRUE(tile.isRenderable());
 }
 
 TEST(RasterTile, onParsedEmpty) {
     RasterTileTest test;
-    RasterTile tile(OverscaledTileID(0, 0, 0), test.updateParameters, test.tileset);
+    RasterTile tile(OverscaledTileID(0, 0, 0), test.updateParameters, test.tileset, 512);
     tile.onParsed(nullptr);
     EXPECT_FALSE(tile.isRenderable());
 }
@@ -0,0 +1,141 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/tile/tile.hpp>
+#include <mbgl/tile/tile_cache.hpp>
+
+using namespace mbgl;
+
+namespace {
+
+constexpr std::size_t MB = 1024 * 1024;
+
+class FakeTile : public Tile {
+public:
+    FakeTile(const OverscaledTileID& id_, std::size_t bytes_) : Tile(id_), size(bytes_) {
+        availableData = DataAvailability::All;
+    }
+
+    void setNecessity(Necessity) override {}
+    void cancel() override {}
+    Bucket* getBucket(const style::Layer&) override { return nullptr; }
+    MemoryUsage memoryUsage() const override {
+        MemoryUsage result;
+        result.cpu = size / 2;
+        result.gpu = size - result.cpu;
+        return result;
+    }
+
+private:
+    const std::size_t size;
+};
+
+std::unique_ptr<Tile> tile(uint32_t x, std::size_t bytes) {
+    return std::make_unique<FakeTile>(OverscaledTileID(4, x, 0), bytes);
+}
+
+} // namespace
+
+TEST(TileCache, ByteBudget) {
+    TileCache cache(3 * MB);
+
+    cache.add(OverscaledTileID(4, 0, 0), tile(0, MB));
+    cache.add(OverscaledTileID(4, 1, 0), tile(1, MB));
+    EXPECT_EQ(2u, cache.size());
+    EXPECT_LT(2 * MB, cache.getBytes());
+
+    // A large tile evicts several small ones, least recently used first.
+    cache.add(OverscaledTileID(4, 2, 0), tile(2, 2 * MB));
+    EXPECT_FALSE(cache.has(OverscaledTileID(4, 0, 0)));
+    EXPECT_FALSE(cache.has(OverscaledTileID(4, 1, 0)));
+    EXPECT_TRUE(cache.has(OverscaledTileID(4, 2, 0)));
+
+    // Tiles that exceed the whole budget are not cached.
+    cache.add(OverscaledTileID(4, 3, 0), tile(3, 4 * MB));
+    EXPECT_FALSE(cache.has(OverscaledTileID(4, 3, 0)));
+    EXPECT_TRUE(cache.has(OverscaledTileID(4, 2, 0)));
+
+    cache.setMaxBytes(MB);
+    EXPECT_EQ(0u, cache.size());
+    EXPECT_EQ(0u, cache.getBytes());
+}
+
+TEST(TileCache, GetMarksUse) {
+    TileCache cache(3 * MB);
+
+    cache.add(OverscaledTileID(4, 0, 0), tile(0, MB));
+    cache.add(OverscaledTileID(4, 1, 0), tile(1, MB));
+
+    // Taking a tile out and putting it back makes it the most recently used one.
+    auto first = cache.get(OverscaledTileID(4, 0, 0));
+    ASSERT_TRUE(first);
+    EXPECT_FALSE(cache.has(OverscaledTileID(4, 0, 0)));
+    cache.add(OverscaledTileID(4, 0, 0), std::move(first));
+
+    cache.add(OverscaledTileID(4, 2, 0), tile(2, MB));
+    EXPECT_TRUE(cache.has(OverscaledTileID(4, 0, 0)));
+    EXPECT_FALSE(cache.has(OverscaledTileID(4, 1, 0)));
+    EXPECT_TRUE(cache.has(OverscaledTileID(4, 2, 0)));
+    EXPECT_FALSE(cache.get(OverscaledTileID(4, 1, 0)));
+}
+
+TEST(TileCache, RemoveIf) {
+    TileCache cache(10 * MB);
+
+    for (uint32_t x = 0; x < 6; ++x) {
+        cache.add(OverscaledTileID(4, x, 0), tile(x, MB));
+    }
+
+    cache.removeIf([] (const OverscaledTileID& id) { return id.canonical.x % 2; });
+    EXPECT_EQ(3u, cache.size());
+    EXPECT_TRUE(cache.has(OverscaledTileID(4, 0, 0)));
+    EXPECT_FALSE(cache.has(OverscaledTileID(4, 1, 0)));
+    EXPECT_GT(4 * MB, cache.getBytes());
+
+    cache.clear();
+    EXPECT_EQ(0u, cache.size());
+    EXPECT_EQ(0u, cache.getBytes());
+}
+
+TEST(TileCache, SharedBudget) {
+    auto budget = std::make_shared<TileCache::Budget>(3 * MB);
+    TileCache a(budget);
+    TileCache b(budget);
+
+    a.add(OverscaledTileID(4, 0, 0), tile(0, MB));
+    b.add(OverscaledTileID(4, 0, 0), tile(0, MB));
+    a.add(OverscaledTileID(4, 1, 0), tile(1, MB / 2));
+    EXPECT_EQ(a.getBytes() + b.getBytes(), budget->getBytes());
+
+    // The least recently used tile of either cache is evicted.
+    b.add(OverscaledTileID(4, 1, 0), tile(1, MB));
+    EXPECT_FALSE(a.has(OverscaledTileID(4, 0, 0)));
+    EXPECT_TRUE(a.has(OverscaledTileID(4, 1, 0)));
+    EXPECT_TRUE(b.has(OverscaledTileID(4, 0, 0)));
+    EXPECT_TRUE(b.has(OverscaledTileID(4, 1, 0)));
+
+    // Moving a cache to a budget of its own takes its tiles along.
+    b.setBudget(nullptr);
+    EXPECT_EQ(a.getBytes(), budget->getBytes());
+    EXPECT_EQ(3 * MB, b.getMaxBytes());
+    EXPECT_TRUE(b.has(OverscaledTileID(4, 0, 0)));
+    EXPECT_TRUE(b.has(OverscaledTileID(4, 1, 0)));
+
+    budget->setMaxBytes(0);
+    EXPECT_EQ(0u, a.size());
+    EXPECT_EQ(2u, b.size());
+}
+
+TEST(TileCache, TileBytes) {
+    // Empty tiles are charged for the tile object and its entry.
+    auto empty = tile(0, 0);
+    EXPECT_LT(0u, TileCache::tileOverhead());
+    EXPECT_EQ(TileCache::tileOverhead(), TileCache::tileBytes(*empty));
+    EXPECT_EQ(MB + TileCache::tileOverhead(), TileCache::tileBytes(*tile(1, MB)));
+
+    TileCache cache(3 * TileCache::tileOverhead());
+    for (uint32_t x = 0; x < 4; ++x) {
+        cache.add(OverscaledTileID(4, x, 0), tile(x, 0));
+    }
+    EXPECT_EQ(3u, cache.size());
+    EXPECT_EQ(3 * TileCache::tileOverhead(), cache.getBytes());
+}
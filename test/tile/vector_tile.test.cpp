@@ -1,9 +1,11 @@
 #include <mbgl/test/util.hpp>
 #include <mbgl/test/fake_file_source.hpp>
 #include <mbgl/tile/vector_tile.hpp>
+#include <mbgl/tile/vector_tile_data.hpp>
 #include <mbgl/tile/tile_loader_impl.hpp>
 
 #include <mbgl/util/default_thread_pool.hpp>
+#include <mbgl/util/io.hpp>
 #include <mbgl/util/run_loop.hpp>
 #include <mbgl/map/transform.hpp>
 #include <mbgl/style/style.hpp>
@@ -94,4 +96,31 @@ TEST(VectorTile, Issue8542) {
     // Query before data is set
     std::vector<Feature> result;
     tile.querySourceFeatures(result, { { {"layer"} }, {} });
-}
\ No newline at end of file
+}
+TEST(VectorTileData, EachFeature) {
+    VectorTileData data(std::make_shared<std::string>(
+        util::read_file("test/fixtures/api/assets/streets/10-163-395.vector.pbf")));
+
+    const GeometryTileLayer* layer = data.getLayer("road");
+    ASSERT_TRUE(layer);
+
+    // Transient features match the owning features returned by getFeature().
+    std::size_t visited = 0;
+    layer->eachFeature([&] (std::size_t i, const GeometryTileFeature& feature) {
+        EXPECT_EQ(visited++, i);
+        std::unique_ptr<GeometryTileFeature> owned = layer->getFeature(i);
+        EXPECT_EQ(owned->getType(), feature.getType());
+        EXPECT_EQ(owned->getID(), feature.getID());
+        EXPECT_EQ(owned->getProperties(), feature.getProperties());
+        EXPECT_EQ(owned->getGeometries(), feature.getGeometries());
+        return true;
+    });
+    EXPECT_EQ(layer->featureCount(), visited);
+
+    // Returning false stops the iteration.
+    visited = 0;
+    layer->eachFeature([&] (std::size_t, const GeometryTileFeature&) {
+        return ++visited < 3;
+    });
+    EXPECT_EQ(3u, visited);
+}
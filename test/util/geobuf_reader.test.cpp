@@ -0,0 +1,125 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/util/geobuf_reader.hpp>
+
+#include <protozero/pbf_writer.hpp>
+
+using namespace mbgl;
+using namespace mbgl::util;
+
+namespace {
+
+void writeGeometry(protozero::pbf_writer& parent,
+                   int32_t type,
+                   const std::vector<uint32_t>& lengths,
+                   const std::vector<int64_t>& coords) {
+    protozero::pbf_writer geometry(parent, 1 /* geometry */);
+    geometry.add_enum(1 /* type */, type);
+    if (!lengths.empty()) {
+        geometry.add_packed_uint32(2 /* lengths */, lengths.begin(), lengths.end());
+    }
+    geometry.add_packed_sint64(3 /* coords */, coords.begin(), coords.end());
+}
+
+// A feature collection with a point, a polygon and a multipolygon, at a precision of two
+// decimal places.
+std::string encodeFeatureCollection() {
+    std::string data;
+    protozero::pbf_writer pbf(data);
+    for (const char* key : { "name", "n", "neg", "obj", "flag" }) {
+        pbf.add_string(1 /* keys */, key);
+    }
+    pbf.add_uint32(3 /* precision */, 2);
+
+    protozero::pbf_writer collection(pbf, 4 /* feature_collection */);
+    {
+        protozero::pbf_writer feature(collection, 1 /* features */);
+        writeGeometry(feature, 0 /* POINT */, {}, { 150, -225 });
+        feature.add_sint64(12 /* int_id */, -3);
+        { protozero::pbf_writer value(feature, 13); value.add_string(1, "a"); }
+        { protozero::pbf_writer value(feature, 13); value.add_uint64(3, 7); }
+        { protozero::pbf_writer value(feature, 13); value.add_uint64(4, 4); }
+        { protozero::pbf_writer value(feature, 13); value.add_string(6, R"JSON({"x":[1,2]})JSON"); }
+        { protozero::pbf_writer value(feature, 13); value.add_bool(5, true); }
+        const std::vector<uint32_t> properties = { 0, 0, 1, 1, 2, 2, 3, 3, 4, 4 };
+        feature.add_packed_uint32(14 /* properties */, properties.begin(), properties.end());
+    }
+    {
+        protozero::pbf_writer feature(collection, 1 /* features */);
+        writeGeometry(feature, 4 /* POLYGON */, {}, { 0, 0, 100, 0, 0, 100 });
+        feature.add_string(11 /* id */, "b");
+    }
+    {
+        protozero::pbf_writer feature(collection, 1 /* features */);
+        writeGeometry(feature, 5 /* MULTIPOLYGON */, { 2, 1, 3, 1, 3 },
+                      { 0, 0, 100, 0, 0, 100, 500, 500, 100, 0, 0, 100 });
+    }
+
+    return data;
+}
+
+} // namespace
+
+TEST(GeobufReader, FeatureCollection) {
+    const GeoJSON geoJSON = parseGeobuf(encodeFeatureCollection());
+    ASSERT_TRUE(geoJSON.is<FeatureCollection>());
+    const auto& features = geoJSON.get<FeatureCollection>();
+    ASSERT_EQ(3u, features.size());
+
+    EXPECT_EQ(mapbox::geometry::point<double>(1.5, -2.25),
+              features[0].geometry.get<mapbox::geometry::point<double>>());
+    EXPECT_EQ(FeatureIdentifier(int64_t(-3)), *features[0].id);
+    EXPECT_EQ(Value(std::string("a")), features[0].properties.at("name"));
+    EXPECT_EQ(Value(uint64_t(7)), features[0].properties.at("n"));
+    EXPECT_EQ(Value(int64_t(-4)), features[0].properties.at("neg"));
+    EXPECT_EQ(Value(true), features[0].properties.at("flag"));
+    EXPECT_EQ(2u, features[0].properties.at("obj").get<PropertyMap>().at("x")
+                  .get<std::vector<Value>>().size());
+
+    // Rings are closed again.
+    EXPECT_EQ(FeatureIdentifier(std::string("b")), *features[1].id);
+    const auto& polygon = features[1].geometry.get<mapbox::geometry::polygon<double>>();
+    ASSERT_EQ(1u, polygon.size());
+    ASSERT_EQ(4u, polygon[0].size());
+    EXPECT_EQ(mapbox::geometry::point<double>(1, 1), polygon[0][2]);
+    EXPECT_EQ(polygon[0][0], polygon[0][3]);
+
+    // Deltas start over with each ring.
+    const auto& polygons = features[2].geometry.get<mapbox::geometry::multi_polygon<double>>();
+    ASSERT_EQ(2u, polygons.size());
+    ASSERT_EQ(1u, polygons[1].size());
+    ASSERT_EQ(4u, polygons[1][0].size());
+    EXPECT_EQ(mapbox::geometry::point<double>(6, 5), polygons[1][0][1]);
+}
+
+TEST(GeobufReader, Features) {
+    std::size_t count = 0;
+    parseGeobufFeatures(encodeFeatureCollection(), [&] (Feature&&) {
+        ++count;
+    });
+    EXPECT_EQ(3u, count);
+}
+
+TEST(GeobufReader, IsGeobuf) {
+    EXPECT_TRUE(isGeobuf(encodeFeatureCollection()));
+    EXPECT_FALSE(isGeobuf(R"JSON({ "type": "FeatureCollection", "features": [] })JSON"));
+    EXPECT_FALSE(isGeobuf("\n  {}"));
+    EXPECT_FALSE(isGeobuf(""));
+}
+
+TEST(GeobufReader, Errors) {
+    const std::string data = encodeFeatureCollection();
+    EXPECT_ANY_THROW(parseGeobuf(data.substr(0, data.size() - 3)));
+
+    std::string empty;
+    protozero::pbf_writer(empty).add_uint32(3 /* precision */, 2);
+    EXPECT_ANY_THROW(parseGeobuf(empty));
+
+    std::string inconsistent;
+    {
+        protozero::pbf_writer pbf(inconsistent);
+        protozero::pbf_writer feature(pbf, 5 /* feature */);
+        writeGeometry(feature, 5 /* MULTIPOLYGON */, { 2, 1, 3 }, { 0, 0, 100, 0, 0, 100 });
+    }
+    EXPECT_ANY_THROW(parseGeobuf(inconsistent));
+}
@@ -0,0 +1,118 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/util/geojson_reader.hpp>
+
+using namespace mbgl;
+using namespace mbgl::util;
+
+TEST(GeoJSONReader, FeatureCollection) {
+    const GeoJSON geoJSON = parseGeoJSON(R"JSON({
+        "type": "FeatureCollection",
+        "features": [{
+            "type": "Feature",
+            "id": 7,
+            "properties": { "name": "a", "rank": -2, "tags": [1, "b", null], "nested": { "x": 1.5 } },
+            "geometry": { "type": "Point", "coordinates": [1, 2, 3] }
+        }, {
+            "geometry": { "coordinates": [[[0, 0], [1, 0], [1, 1], [0, 0]]], "type": "Polygon" },
+            "properties": null,
+            "id": "b",
+            "type": "Feature"
+        }]
+    })JSON");
+
+    ASSERT_TRUE(geoJSON.is<FeatureCollection>());
+    const auto& features = geoJSON.get<FeatureCollection>();
+    ASSERT_EQ(2u, features.size());
+
+    EXPECT_EQ(FeatureIdentifier(uint64_t(7)), *features[0].id);
+    EXPECT_EQ(Value(std::string("a")), features[0].properties.at("name"));
+    EXPECT_EQ(Value(int64_t(-2)), features[0].properties.at("rank"));
+    EXPECT_EQ(3u, features[0].properties.at("tags").get<std::vector<Value>>().size());
+    EXPECT_EQ(Value(1.5), features[0].properties.at("nested").get<PropertyMap>().at("x"));
+    EXPECT_EQ(mapbox::geometry::point<double>(1, 2),
+              features[0].geometry.get<mapbox::geometry::point<double>>());
+
+    // Members may come in any order.
+    EXPECT_EQ(FeatureIdentifier(std::string("b")), *features[1].id);
+    EXPECT_TRUE(features[1].properties.empty());
+    const auto& polygon = features[1].geometry.get<mapbox::geometry::polygon<double>>();
+    ASSERT_EQ(1u, polygon.size());
+    EXPECT_EQ(4u, polygon[0].size());
+}
+
+TEST(GeoJSONReader, Geometries) {
+    const GeoJSON geoJSON = parseGeoJSON(R"JSON({
+        "type": "GeometryCollection",
+        "bbox": [0, 0, 10, 10],
+        "geometries": [
+            { "type": "MultiPoint", "coordinates": [[0, 0], [1, 1]] },
+            { "type": "LineString", "coordinates": [[0, 0], [1, 1], [2, 2]] },
+            { "type": "MultiLineString", "coordinates": [[[0, 0], [1, 1]], [[2, 2], [3, 3], [4, 4]]] },
+            { "type": "MultiPolygon", "coordinates": [
+                [[[0, 0], [1, 0], [1, 1], [0, 0]], [[0.2, 0.2], [0.8, 0.2], [0.8, 0.8], [0.2, 0.2]]],
+                [[[5, 5], [6, 5], [6, 6], [5, 5]]]
+            ] }
+        ]
+    })JSON");
+
+    ASSERT_TRUE(geoJSON.is<mapbox::geometry::geometry<double>>());
+    const auto& geometries = geoJSON.get<mapbox::geometry::geometry<double>>()
+        .get<mapbox::geometry::geometry_collection<double>>();
+    ASSERT_EQ(4u, geometries.size());
+
+    EXPECT_EQ(2u, geometries[0].get<mapbox::geometry::multi_point<double>>().size());
+    EXPECT_EQ(3u, geometries[1].get<mapbox::geometry::line_string<double>>().size());
+
+    const auto& lines = geometries[2].get<mapbox::geometry::multi_line_string<double>>();
+    ASSERT_EQ(2u, lines.size());
+    EXPECT_EQ(2u, lines[0].size());
+    EXPECT_EQ(3u, lines[1].size());
+    EXPECT_EQ(mapbox::geometry::point<double>(4, 4), lines[1][2]);
+
+    const auto& polygons = geometries[3].get<mapbox::geometry::multi_polygon<double>>();
+    ASSERT_EQ(2u, polygons.size());
+    ASSERT_EQ(2u, polygons[0].size());
+    EXPECT_EQ(mapbox::geometry::point<double>(0.8, 0.2), polygons[0][1][1]);
+    ASSERT_EQ(1u, polygons[1].size());
+    EXPECT_EQ(mapbox::geometry::point<double>(6, 5), polygons[1][0][1]);
+}
+
+TEST(GeoJSONReader, Features) {
+    std::vector<Feature> features;
+    parseGeoJSONFeatures(R"JSON({
+        "features": [
+            { "type": "Feature", "properties": {}, "geometry": { "type": "Point", "coordinates": [0, 0] } },
+            { "type": "Feature", "properties": {}, "geometry": null }
+        ],
+        "type": "FeatureCollection"
+    })JSON", [&] (Feature&& feature) {
+        features.push_back(std::move(feature));
+    });
+
+    ASSERT_EQ(2u, features.size());
+    EXPECT_TRUE(features[1].geometry.is<mapbox::geometry::geometry_collection<double>>());
+
+    features.clear();
+    parseGeoJSONFeatures(R"JSON({ "type": "Point", "coordinates": [1, 2] })JSON",
+                         [&] (Feature&& feature) {
+        features.push_back(std::move(feature));
+    });
+
+    ASSERT_EQ(1u, features.size());
+    EXPECT_EQ(mapbox::geometry::point<double>(1, 2),
+              features[0].geometry.get<mapbox::geometry::point<double>>());
+}
+
+TEST(GeoJSONReader, Errors) {
+    EXPECT_THROW(parseGeoJSON(""), std::runtime_error);
+    EXPECT_THROW(parseGeoJSON("{ \"type\": \"Point\", \"coordinates\": [1, 2] "), std::runtime_error);
+    EXPECT_THROW(parseGeoJSON("[]"), std::runtime_error);
+    EXPECT_THROW(parseGeoJSON("{ \"coordinates\": [1, 2] }"), std::runtime_error);
+    EXPECT_THROW(parseGeoJSON("{ \"type\": \"Point\" }"), std::runtime_error);
+    EXPECT_THROW(parseGeoJSON("{ \"type\": \"Circle\", \"coordinates\": [1, 2] }"), std::runtime_error);
+    EXPECT_THROW(parseGeoJSON("{ \"type\": \"Point\", \"coordinates\": [1] }"), std::runtime_error);
+    EXPECT_THROW(parseGeoJSON("{ \"type\": \"Point\", \"coordinates\": [\"1\", 2] }"), std::runtime_error);
+    EXPECT_THROW(parseGeoJSON("{ \"type\": \"LineString\", \"coordinates\": [1, 2] }"), std::runtime_error);
+    EXPECT_THROW(parseGeoJSON("{ \"type\": \"FeatureCollection\", \"features\": [{ \"type\": \"Point\", \"coordinates\": [1, 2] }] }"), std::runtime_error);
+}
@@ -50,6 +50,14 @@ TEST(Image, PNGReadNoProfileAlpha) {
     EXPECT_EQ(128, image.data[3]);
 }
 
+TEST(Image, PNGReadNoProfileAlphaUnassociated) {
+    UnassociatedImage image = decodeUnassociatedImage(util::read_file("test/fixtures/image/no_profile_alpha.png"));
+    EXPECT_EQ(128, image.data[0]);
+    EXPECT_EQ(0, image.data[1]);
+    EXPECT_EQ(0, image.data[2]);
+    EXPECT_EQ(128, image.data[3]);
+}
+
 TEST(Image, PNGReadProfile) {
     PremultipliedImage image = decodeImage(util::read_file("test/fixtures/image/profile.png"));
     EXPECT_EQ(128, image.data[0]);
@@ -78,12 +86,34 @@ TEST(Image, JPEGTile) {
     EXPECT_EQ(256u, image.size.height);
 }
 
+TEST(Image, JPEGTileUnassociated) {
+    UnassociatedImage image = decodeUnassociatedImage(util::read_file("test/fixtures/image/tile.jpeg"));
+    EXPECT_EQ(256u, image.size.width);
+    EXPECT_EQ(256u, image.size.height);
+    EXPECT_EQ(255, image.data[3]);
+}
+
 #if !defined(__ANDROID__) && !defined(__APPLE__) && !defined(QT_IMAGE_DECODERS)
+TEST(Image, JPEGTileScaled) {
+    const std::string data = util::read_file("test/fixtures/image/tile.jpeg");
+    EXPECT_EQ(Size(128, 128), decodeUnassociatedImage(data, { 128, 128 }).size);
+    EXPECT_EQ(Size(128, 128), decodeUnassociatedImage(data, { 100, 120 }).size);
+    EXPECT_EQ(Size(256, 256), decodeUnassociatedImage(data, { 200, 100 }).size);
+    EXPECT_EQ(Size(256, 256), decodeUnassociatedImage(data, { 512, 512 }).size);
+    EXPECT_EQ(Size(32, 32), decodeUnassociatedImage(data, { 1, 1 }).size);
+}
+
 TEST(Image, WebPTile) {
     PremultipliedImage image = decodeImage(util::read_file("test/fixtures/image/tile.webp"));
     EXPECT_EQ(256u, image.size.width);
     EXPECT_EQ(256u, image.size.height);
 }
+
+TEST(Image, WebPTileScaled) {
+    const std::string data = util::read_file("test/fixtures/image/tile.webp");
+    EXPECT_EQ(Size(128, 128), decodeUnassociatedImage(data, { 128, 128 }).size);
+    EXPECT_EQ(Size(256, 256), decodeUnassociatedImage(data, { 200, 200 }).size);
+}
 #endif // !defined(__ANDROID__) && !defined(__APPLE__) && !defined(QT_IMAGE_DECODERS)
 
 TEST(Image, Copy) {
@@ -128,3 +158,46 @@ TEST(Image, Premultiply) {
     EXPECT_EQ(127, image.data[2]);
     EXPECT_EQ(128, image.data[3]);
 }
+
+// Every color and alpha combination, so that both the vectorized and the scalar paths are
+// compared against the reference formulas.
+TEST(Image, PremultiplyAll) {
+    UnassociatedImage rgba({ 256, 256 });
+    for (uint32_t a = 0; a < 256; a++) {
+        for (uint32_t c = 0; c < 256; c++) {
+            uint8_t* pixel = rgba.data.get() + (a * 256 + c) * 4;
+            pixel[0] = pixel[1] = pixel[2] = c;
+            pixel[3] = a;
+        }
+    }
+
+    PremultipliedImage image = util::premultiply(std::move(rgba));
+    for (uint32_t a = 0; a < 256; a++) {
+        for (uint32_t c = 0; c < 256; c++) {
+            const uint8_t* pixel = image.data.get() + (a * 256 + c) * 4;
+            ASSERT_EQ((c * a + 127) / 255, pixel[0]) << "c=" << c << " a=" << a;
+            ASSERT_EQ(a, pixel[3]);
+        }
+    }
+}
+
+TEST(Image, UnpremultiplyAll) {
+    PremultipliedImage image({ 256, 256 });
+    for (uint32_t a = 0; a < 256; a++) {
+        for (uint32_t c = 0; c < 256; c++) {
+            uint8_t* pixel = image.data.get() + (a * 256 + c) * 4;
+            pixel[0] = pixel[1] = pixel[2] = c;
+            pixel[3] = a;
+        }
+    }
+
+    UnassociatedImage rgba = util::unpremultiply(std::move(image));
+    for (uint32_t a = 0; a < 256; a++) {
+        for (uint32_t c = 0; c < 256; c++) {
+            const uint8_t* pixel = rgba.data.get() + (a * 256 + c) * 4;
+            const uint8_t expected = a ? uint8_t((255 * c + a / 2) / a) : c;
+            ASSERT_EQ(expected, pixel[0]) << "c=" << c << " a=" << a;
+            ASSERT_EQ(a, pixel[3]);
+        }
+    }
+}
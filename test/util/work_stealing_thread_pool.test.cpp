@@ -0,0 +1,151 @@
+#include <mbgl/actor/actor.hpp>
+#include <mbgl/util/work_stealing_thread_pool.hpp>
+
+#include <mbgl/test/util.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <memory>
+#include <vector>
+
+using namespace mbgl;
+
+TEST(WorkStealingThreadPool, MessageOrder) {
+    // Messages sent to a single actor are processed in order, even when the actor
+    // is picked up by different workers.
+
+    struct Test {
+        int last = 0;
+        std::promise<void> promise;
+
+        Test(ActorRef<Test>, std::promise<void> promise_)
+            : promise(std::move(promise_)) {
+        }
+
+        void receive(int i) {
+            EXPECT_EQ(i, last + 1);
+            last = i;
+        }
+
+        void end() {
+            promise.set_value();
+        }
+    };
+
+    WorkStealingThreadPool pool { 4 };
+
+    std::promise<void> endedPromise;
+    std::future<void> endedFuture = endedPromise.get_future();
+    Actor<Test> test(pool, std::move(endedPromise));
+
+    for (auto i = 1; i <= 1000; ++i) {
+        test.invoke(&Test::receive, i);
+    }
+
+    test.invoke(&Test::end);
+    endedFuture.wait();
+}
+
+TEST(WorkStealingThreadPool, ManyActors) {
+    // Scheduling from worker threads (local deques) and from the outside (injection queue),
+    // with more mailboxes than the injection queue can hold at once.
+
+    struct Test {
+        ActorRef<Test> self;
+        std::atomic<int>& remaining;
+        std::promise<void>& promise;
+
+        Test(ActorRef<Test> self_, std::atomic<int>& remaining_, std::promise<void>& promise_)
+            : self(std::move(self_)),
+              remaining(remaining_),
+              promise(promise_) {
+        }
+
+        void bounce(int times) {
+            if (times > 0) {
+                self.invoke(&Test::bounce, times - 1);
+            } else if (--remaining == 0) {
+                promise.set_value();
+            }
+        }
+    };
+
+    WorkStealingThreadPool pool { 8 };
+
+    const int count = 2000;
+    std::atomic<int> remaining { count };
+    std::promise<void> promise;
+    std::future<void> future = promise.get_future();
+
+    std::vector<std::unique_ptr<Actor<Test>>> actors;
+    for (int i = 0; i < count; ++i) {
+        actors.push_back(std::make_unique<Actor<Test>>(pool, std::ref(remaining), std::ref(promise)));
+    }
+
+    for (auto& actor : actors) {
+        actor->invoke(&Test::bounce, 10);
+    }
+
+    future.wait();
+    EXPECT_EQ(0, remaining);
+}
+
+TEST(WorkStealingThreadPool, OverflowKeepsPriority) {
+    // Mailboxes that don't fit in the injection queue of their priority are still received
+    // in order of priority.
+
+    struct Test {
+        std::vector<int>& received;
+
+        Test(ActorRef<Test>, std::vector<int>& received_)
+            : received(received_) {
+        }
+
+        void block(std::shared_future<void> future) {
+            future.wait();
+        }
+
+        void receive(int i) {
+            received.push_back(i);
+        }
+    };
+
+    WorkStealingThreadPool pool { 1 };
+
+    std::vector<int> received;
+    Actor<Test> blocker(pool, std::ref(received));
+
+    // Occupy the only thread so that the other mailboxes queue up behind it.
+    std::promise<void> unblock;
+    blocker.invoke(&Test::block, unblock.get_future().share());
+
+    // More mailboxes of each priority than an injection queue holds.
+    const int count = 1500;
+    std::vector<std::unique_ptr<Actor<Test>>> actors;
+    for (auto priority : { Scheduler::Priority::Low, Scheduler::Priority::Normal, Scheduler::Priority::High }) {
+        for (int i = 0; i < count; ++i) {
+            actors.push_back(std::make_unique<Actor<Test>>(pool, std::ref(received)));
+            actors.back()->setPriority(priority);
+            actors.back()->invoke(&Test::receive, int(priority));
+        }
+    }
+
+    std::promise<void> endedPromise;
+    std::future<void> endedFuture = endedPromise.get_future();
+
+    // Enqueued last with the lowest priority, so it completes last.
+    struct End {
+        End(ActorRef<End>) {}
+        void end(std::promise<void> promise) { promise.set_value(); }
+    };
+    Actor<End> end(pool);
+    end.setPriority(Scheduler::Priority::Low);
+    end.invoke(&End::end, std::move(endedPromise));
+
+    unblock.set_value();
+    endedFuture.wait();
+
+    ASSERT_EQ(3u * count, received.size());
+    EXPECT_TRUE(std::is_sorted(received.rbegin(), received.rend()));
+}